@@ -0,0 +1,184 @@
+#include "AnalysisPublisher.h"
+
+//==============================================================================
+AnalysisPublisher::AnalysisPublisher (const LevelMeterBank& levelsToPublish)
+    : juce::Thread ("OSC Publisher"), levels (levelsToPublish)
+{
+    buffer.allocate (bufferSize, true);
+}
+
+AnalysisPublisher::~AnalysisPublisher()
+{
+    disconnect();
+}
+
+bool AnalysisPublisher::connect (const juce::String& host, int port)
+{
+    disconnect();
+
+    targetHost = host;
+    targetPort = port;
+    queueFifo.reset();
+
+    connected.store (true, std::memory_order_release);
+    startThread();
+    return true;
+}
+
+void AnalysisPublisher::disconnect()
+{
+    connected.store (false, std::memory_order_release);
+    stopThread (2000);
+}
+
+void AnalysisPublisher::publishHop (const HopResult& result)
+{
+    if (! connected.load (std::memory_order_acquire))
+        return;
+
+    int start1, size1, start2, size2;
+    queueFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 + size2 < 1)
+        return;                  // Writer behind; drop rather than wait
+
+    queue[size1 > 0 ? start1 : start2] = result;
+    queueFifo.finishedWrite (1);
+    notify();
+}
+
+//==============================================================================
+void AnalysisPublisher::run()
+{
+    while (! threadShouldExit())
+    {
+        if (queueFifo.getNumReady() == 0)
+        {
+            wait (10);
+            continue;
+        }
+
+        int start1, size1, start2, size2;
+        queueFifo.prepareToRead (1, start1, size1, start2, size2);
+
+        const HopResult result = queue[size1 > 0 ? start1 : start2];
+        queueFifo.finishedRead (1);
+
+        sendBundle (result);
+    }
+}
+
+void AnalysisPublisher::sendBundle (const HopResult& result)
+{
+    // OSC timetag: NTP epoch seconds in the high word, 2^32 fractions in
+    // the low, so the Python side can order bundles across the wire
+    const auto nowMs = (juce::uint64) juce::Time::currentTimeMillis();
+    const auto timeTag = ((nowMs / 1000 + 2208988800ULL) << 32)
+                          + (((nowMs % 1000) << 32) / 1000);
+
+    cursor = 0;
+    writeString ("#bundle");
+    writeUint64 (timeTag);
+
+    // Each element is a size-prefixed OSC message; the size is patched in
+    // once the message is complete
+    auto beginElement = [this]
+    {
+        const int sizeField = cursor;
+        writeInt32 (0);
+        return sizeField;
+    };
+
+    auto endElement = [this] (int sizeField)
+    {
+        const juce::int32 elementSize = cursor - sizeField - 4;
+        auto* patch = buffer + sizeField;
+        patch[0] = (char) (elementSize >> 24);
+        patch[1] = (char) (elementSize >> 16);
+        patch[2] = (char) (elementSize >> 8);
+        patch[3] = (char) elementSize;
+    };
+
+    if (result.chordChanged && result.chord >= 0)
+    {
+        const int element = beginElement();
+        writeString ("/performia/chord");
+        writeString (",if");
+        writeInt32 (result.chord);
+        writeFloat32 (result.confidence);
+        endElement (element);
+    }
+
+    if (result.onset)
+    {
+        const int element = beginElement();
+        writeString ("/performia/onset");
+        writeString (",");
+        endElement (element);
+    }
+
+    {
+        const int element = beginElement();
+        writeString ("/performia/beat");
+        writeString (",ff");
+        writeFloat32 (result.tempoBpm);
+        writeFloat32 (result.beatPhase);
+        endElement (element);
+    }
+
+    {
+        const int numChannels = juce::jmin (levels.getNumChannels(),
+                                            LevelMeterBank::maxChannels);
+
+        char typeTags[LevelMeterBank::maxChannels + 2];
+        typeTags[0] = ',';
+        for (int i = 0; i < numChannels; ++i)
+            typeTags[i + 1] = 'f';
+        typeTags[numChannels + 1] = 0;
+
+        const int element = beginElement();
+        writeString ("/performia/levels");
+        writeString (typeTags);
+        for (int i = 0; i < numChannels; ++i)
+            writeFloat32 (levels.getPeak (i));
+        endElement (element);
+    }
+
+    socket.write (targetHost, targetPort, buffer, cursor);
+}
+
+//==============================================================================
+void AnalysisPublisher::writeInt32 (juce::int32 value)
+{
+    jassert (cursor + 4 <= bufferSize);
+    buffer[cursor++] = (char) (value >> 24);
+    buffer[cursor++] = (char) (value >> 16);
+    buffer[cursor++] = (char) (value >> 8);
+    buffer[cursor++] = (char) value;
+}
+
+void AnalysisPublisher::writeUint64 (juce::uint64 value)
+{
+    writeInt32 ((juce::int32) (value >> 32));
+    writeInt32 ((juce::int32) value);
+}
+
+void AnalysisPublisher::writeFloat32 (float value)
+{
+    juce::int32 bits;
+    std::memcpy (&bits, &value, sizeof (bits));
+    writeInt32 (bits);
+}
+
+void AnalysisPublisher::writeString (const char* text)
+{
+    // OSC strings are null-terminated and zero-padded to four bytes
+    const auto length = (int) std::strlen (text);
+    jassert (cursor + length + 4 <= bufferSize);
+
+    std::memcpy (buffer + cursor, text, (size_t) length);
+    cursor += length;
+
+    for (int pad = 4 - (length % 4); pad > 0; --pad)
+        buffer[cursor++] = 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "Metering.h"
+
+//==============================================================================
+/** One analysis hop's worth of results, as produced by the chord detector
+    and beat tracker.
+*/
+struct HopResult
+{
+    int chord = -1;
+    float confidence = 0.0f;
+    bool chordChanged = false;
+    bool onset = false;
+    float tempoBpm = 0.0f;
+    float beatPhase = 0.0f;
+};
+
+//==============================================================================
+/**
+    Consumer of per-hop analysis results. The live path batches them onto
+    the wire (AnalysisPublisher below); the offline renderer collects them
+    into a results file instead.
+*/
+class AnalysisSink
+{
+public:
+    virtual ~AnalysisSink() = default;
+
+    /** Called once per analysed hop, from whichever thread ran the hop. */
+    virtual void publishHop (const HopResult& result) = 0;
+};
+
+//==============================================================================
+/**
+    Batched OSC output of analysis results.
+
+    The analysis stages used to fire one UDP datagram per result straight
+    from their worker jobs - fine for a chord every few seconds, but with
+    per-hop levels, onsets and beat phase in the pipeline that becomes
+    hundreds of tiny sends per second. Instead, each analysed hop pushes one
+    fixed-size HopResult into a lock-free queue, and a single writer thread
+    coalesces everything that hop produced (chord, per-channel levels, onset
+    flag, tempo and beat phase) into one timestamped OSC bundle serialized
+    into a preallocated buffer: one syscall per hop, flat as more analysis
+    stages land.
+
+    Bundle contents, read by src/agents/listener_agent.py:
+        /performia/chord  i:index f:confidence        (only when it changed)
+        /performia/onset                              (only on onset hops)
+        /performia/beat   f:bpm f:phase
+        /performia/levels f:peak per metered channel
+*/
+class AnalysisPublisher : public AnalysisSink,
+                          private juce::Thread
+{
+public:
+    explicit AnalysisPublisher (const LevelMeterBank& levelsToPublish);
+    ~AnalysisPublisher() override;
+
+    /** Message thread: sets the destination and starts the writer. */
+    bool connect (const juce::String& host, int port);
+    void disconnect();
+
+    /** Worker threads: queues one hop's results. Wait-free; if the writer
+        is somehow behind the hop is dropped rather than waited for.
+    */
+    void publishHop (const HopResult& result) override;
+
+private:
+    void run() override;
+    void sendBundle (const HopResult& result);
+
+    // Serialization cursor into the preallocated buffer
+    void writeInt32 (juce::int32 value);
+    void writeUint64 (juce::uint64 value);
+    void writeFloat32 (float value);
+    void writeString (const char* text);
+
+    const LevelMeterBank& levels;
+
+    // Analysis -> writer hop queue
+    static constexpr int queueSize = 64;
+    juce::AbstractFifo queueFifo { queueSize };
+    HopResult queue[queueSize];
+
+    // One bundle is far smaller than this even at 64 metered channels
+    static constexpr int bufferSize = 4096;
+    juce::HeapBlock<char> buffer;
+    int cursor = 0;
+
+    juce::DatagramSocket socket;
+    juce::String targetHost;
+    int targetPort = 0;
+    std::atomic<bool> connected { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisPublisher)
+};
@@ -1,47 +1,699 @@
 #include "AudioEngine.h"
+#include "WavetableOscillator.h"
 
+//==============================================================================
+// Input conditioning: per-channel gain, DC removal and the optional gate,
+// in place on the raw device input. Runs before everything else so the
+// meters, analysis, recorder and shm bus all see conditioned signal.
+class InputConditionerNode : public AudioEngine::Node
+{
+public:
+    explicit InputConditionerNode (InputConditioner& conditionerToUse)
+        : conditioner (conditionerToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        conditioner.prepare (spec.numInputChannels, spec.sampleRate);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        conditioner.processBlock (context.buffer, context.startSample, context.numSamples);
+    }
+
+    void release() override {}
+
+private:
+    InputConditioner& conditioner;
+};
+
+//==============================================================================
+// Metering: one vectorized pass over every input channel per block. Runs
+// after conditioning so the rest of the graph can read this block's levels
+// for free.
+class MeteringNode : public AudioEngine::Node
+{
+public:
+    MeteringNode (LevelMeterBank& bankToUse, ChannelActivityMap& mapToUse)
+        : bank (bankToUse), activityMap (mapToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        bank.prepare (spec.numInputChannels);
+        activityMap.prepare (spec.numInputChannels, spec.sampleRate, spec.maxBlockSize);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        bank.measureBlock (context.buffer, context.startSample, context.numSamples);
+        activityMap.updateFromMeters (bank);
+    }
+
+    void release() override {}
+
+private:
+    LevelMeterBank& bank;
+    ChannelActivityMap& activityMap;
+};
+
+//==============================================================================
+// Input stage: picks the live input channel from the levels the metering
+// pass already computed. If the selected channel is silent it falls back to
+// the activity map's cached best channel instead of rescanning everything.
+class InputStageNode : public AudioEngine::Node
+{
+public:
+    InputStageNode (LevelMeterBank& bankToUse, ChannelActivityMap& mapToUse)
+        : bank (bankToUse), activityMap (mapToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        numInputChannels = juce::jmin (spec.numInputChannels, LevelMeterBank::maxChannels);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        float maxInput = 0.0f;
+        int activeChannel = -1;
+
+        // First try the selected channel
+        int selected = context.state.selectedInputChannel;
+        if (selected < 0) selected = 0;
+
+        if (selected < numInputChannels)
+        {
+            maxInput = bank.getBlockPeak (selected);
+            if (maxInput > 0.0f)
+                activeChannel = selected;
+        }
+
+        // If no signal on the selected channel, use the cached best channel
+        if (maxInput < 0.0001f)  // Threshold for "no signal"
+        {
+            const int best = activityMap.getBestChannel();
+
+            if (best >= 0 && best < numInputChannels)
+            {
+                maxInput = bank.getBlockPeak (best);
+                activeChannel = best;
+
+                if (best != selected)
+                    activityMap.notifyFallback (best);
+            }
+        }
+
+        context.activeInputChannel = activeChannel;
+        context.inputPeak = maxInput;       // Conditioner gain is already in the buffer
+    }
+
+    void release() override {}
+
+private:
+    LevelMeterBank& bank;
+    ChannelActivityMap& activityMap;
+    int numInputChannels = 0;
+};
+
+//==============================================================================
+// Analysis feed: hands the active input channel to the chord detector's
+// lock-free FIFO, then queues one high-tier job on the worker pool to chew
+// through the complete hops. The jobQueued flag keeps a single job in
+// flight so the detector's sliding window stays single-writer.
+class AnalysisNode : public AudioEngine::Node
+{
+public:
+    AnalysisNode (ChordDetector& detectorToFeed, WorkerPool& poolToUse)
+        : detector (detectorToFeed), pool (poolToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        detector.prepare (spec.sampleRate);
+        jobQueued.store (false, std::memory_order_relaxed);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        if (context.activeInputChannel >= 0
+             && context.activeInputChannel < context.buffer.getNumChannels())
+        {
+            detector.pushSamples (context.buffer.getReadPointer (context.activeInputChannel,
+                                                                 context.startSample),
+                                  context.numSamples);
+
+            if (! jobQueued.exchange (true, std::memory_order_acq_rel))
+                if (! pool.submit (WorkerPool::Priority::high, runJob, this))
+                    jobQueued.store (false, std::memory_order_release);
+        }
+    }
+
+    void release() override {}
+
+private:
+    static void runJob (void* context)
+    {
+        auto* node = static_cast<AnalysisNode*> (context);
+        node->detector.processPendingHops();
+        node->jobQueued.store (false, std::memory_order_release);
+    }
+
+    ChordDetector& detector;
+    WorkerPool& pool;
+    std::atomic<bool> jobQueued { false };
+};
+
+//==============================================================================
+// Waveform tap: one more ring write per block hands the active channel to
+// the history service, then queues a low-tier pool job to fold it into the
+// decimation pyramid - low tier, so chord detection always goes first when
+// the workers are busy.
+class WaveformTapNode : public AudioEngine::Node
+{
+public:
+    WaveformTapNode (WaveformHistory& historyToFeed, WorkerPool& poolToUse)
+        : history (historyToFeed), pool (poolToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        history.prepare (spec.sampleRate);
+        jobQueued.store (false, std::memory_order_relaxed);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        if (context.activeInputChannel >= 0
+             && context.activeInputChannel < context.buffer.getNumChannels())
+        {
+            history.pushSamples (context.buffer.getReadPointer (context.activeInputChannel,
+                                                                context.startSample),
+                                 context.numSamples);
+
+            if (! jobQueued.exchange (true, std::memory_order_acq_rel))
+                if (! pool.submit (WorkerPool::Priority::low, runJob, this))
+                    jobQueued.store (false, std::memory_order_release);
+        }
+    }
+
+    void release() override {}
+
+private:
+    static void runJob (void* context)
+    {
+        auto* node = static_cast<WaveformTapNode*> (context);
+        node->history.processPending();
+        node->jobQueued.store (false, std::memory_order_release);
+    }
+
+    WaveformHistory& history;
+    WorkerPool& pool;
+    std::atomic<bool> jobQueued { false };
+};
+
+//==============================================================================
+// Recording tap: sits before the synthesis stages so it captures the raw
+// device input. One interleaving copy into the recorder ring per block.
+class RecorderNode : public AudioEngine::Node
+{
+public:
+    explicit RecorderNode (Recorder& recorderToFeed) : recorder (recorderToFeed) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        recorder.prepare (spec.numInputChannels, spec.sampleRate);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        recorder.pushBlock (context.buffer, context.startSample, context.numSamples);
+    }
+
+    void release() override
+    {
+        recorder.stopRecording();
+    }
+
+private:
+    Recorder& recorder;
+};
+
+//==============================================================================
+// Shared-memory publish: mirrors the raw active-channel input, the block's
+// per-channel levels and the current chord estimate into the POSIX shm
+// segment the Python agents poll. Sits before the synthesis stages so the
+// agents hear what the musician played, not what the monitor wrote back.
+class ShmPublishNode : public AudioEngine::Node
+{
+public:
+    ShmPublishNode (SharedMemoryBus& busToUse, LevelMeterBank& bankToUse,
+                    ChordDetector& detectorToUse)
+        : bus (busToUse), bank (bankToUse), detector (detectorToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        bus.create (spec.numInputChannels, spec.sampleRate);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        const float* audio = nullptr;
+        if (context.activeInputChannel >= 0
+             && context.activeInputChannel < context.buffer.getNumChannels())
+            audio = context.buffer.getReadPointer (context.activeInputChannel,
+                                                   context.startSample);
+
+        auto& beatTracker = detector.getBeatTracker();
+        bus.publishBlock (audio, context.numSamples, context.samplePosition,
+                          bank, detector.getCurrentChord(),
+                          detector.getCurrentConfidence(),
+                          beatTracker.getTempoBpm(), beatTracker.getBeatPhase());
+    }
+
+    void release() override
+    {
+        bus.close();
+    }
+
+private:
+    SharedMemoryBus& bus;
+    LevelMeterBank& bank;
+    ChordDetector& detector;
+};
+
+//==============================================================================
+// Latency probe: while a measurement is armed, captures the selected input
+// channel and adds the calibration chirp to output channel 0. The capture
+// uses the selected channel, not the activity map's active one: a loopback
+// is digitally silent until the chirp returns, and the capture timeline
+// must start on the block the chirp goes out on or the correlation lag is
+// meaningless. The conditioner has already run by this point, so measure
+// with the gate disabled, and the test tone and monitoring off so nothing
+// overwrites the chirp further down.
+class LatencyProbeNode : public AudioEngine::Node
+{
+public:
+    explicit LatencyProbeNode (LatencyProbe& probeToUse) : probe (probeToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        probe.prepare (spec.sampleRate);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        if (context.buffer.getNumChannels() > 0)
+        {
+            const int captureChannel = juce::jlimit (0, context.buffer.getNumChannels() - 1,
+                                                     context.state.selectedInputChannel);
+
+            probe.captureInput (context.buffer.getReadPointer (captureChannel,
+                                                               context.startSample),
+                                context.numSamples);
+
+            probe.renderOutput (context.buffer.getWritePointer (0, context.startSample),
+                                context.numSamples);
+        }
+    }
+
+    void release() override {}
+
+private:
+    LatencyProbe& probe;
+};
+
+//==============================================================================
+// Test tone: one wavetable walk into the first output channel, then block
+// copies to the rest, so an N-channel line check stays O(samples + copies).
+class TestToneNode : public AudioEngine::Node
+{
+public:
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        numOutputChannels = spec.numOutputChannels;
+        oscillator.prepare (spec.sampleRate);
+        oscillator.reset();
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        if (! context.state.testToneActive)
+            return;
+
+        const int channelsInBuffer = context.buffer.getNumChannels();
+        if (channelsInBuffer == 0 || numOutputChannels == 0)
+            return;
+
+        oscillator.setFrequency (context.state.testToneFrequency);
+
+        auto* firstChannel = context.buffer.getWritePointer (0, context.startSample);
+        oscillator.renderBlock (firstChannel, context.numSamples, 0.3f);
+        context.buffer.applyGainRamp (0, context.startSample, context.numSamples,
+                                      context.outputGainStart, context.outputGainEnd);
+
+        for (int channel = 1; channel < numOutputChannels && channel < channelsInBuffer; ++channel)
+            juce::FloatVectorOperations::copy (context.buffer.getWritePointer (channel, context.startSample),
+                                               firstChannel, context.numSamples);
+
+        auto range = juce::FloatVectorOperations::findMinAndMax (firstChannel, context.numSamples);
+        context.outputPeak = juce::jmax (context.outputPeak,
+                                         -range.getStart(), range.getEnd());
+    }
+
+    void release() override {}
+
+private:
+    WavetableOscillator oscillator;
+    int numOutputChannels = 0;
+};
+
+//==============================================================================
+// Monitor: routes inputs to outputs through the routing matrix. With no
+// routes configured it falls back to fanning the active input channel out to
+// every output; either way gain is applied as one ramp per channel.
+class MonitorNode : public AudioEngine::Node
+{
+public:
+    explicit MonitorNode (RoutingMatrix& matrixToUse) : matrix (matrixToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        numOutputChannels = spec.numOutputChannels;
+        matrix.prepare (spec.numInputChannels, spec.numOutputChannels, spec.maxBlockSize);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        if (! context.state.inputMonitoring || context.state.testToneActive
+             || context.activeInputChannel < 0)
+            return;
+
+        const float gainStart = context.outputGainStart;
+        const float gainEnd = context.outputGainEnd;
+
+        if (matrix.getNumActiveRoutes() > 0)
+        {
+            matrix.apply (context.buffer, context.startSample, context.numSamples,
+                          gainStart, gainEnd);
+        }
+        else
+        {
+            const int channelsInBuffer = context.buffer.getNumChannels();
+            const int activeChannel = context.activeInputChannel;
+            auto* inputData = context.buffer.getReadPointer (activeChannel, context.startSample);
+
+            // Fan the source out before ramping so in-place channels stay valid
+            for (int channel = 0; channel < numOutputChannels && channel < channelsInBuffer; ++channel)
+                if (channel != activeChannel)
+                    juce::FloatVectorOperations::copy (context.buffer.getWritePointer (channel, context.startSample),
+                                                       inputData, context.numSamples);
+
+            for (int channel = 0; channel < numOutputChannels && channel < channelsInBuffer; ++channel)
+                context.buffer.applyGainRamp (channel, context.startSample, context.numSamples,
+                                              gainStart, gainEnd);
+        }
+
+        auto range = juce::FloatVectorOperations::findMinAndMax (
+            context.buffer.getReadPointer (0, context.startSample), context.numSamples);
+        context.outputPeak = juce::jmax (context.outputPeak,
+                                         -range.getStart(), range.getEnd());
+    }
+
+    void release() override {}
+
+private:
+    RoutingMatrix& matrix;
+    int numOutputChannels = 0;
+};
+
+//==============================================================================
+// Agent voices: renders the native synthesis pool on top of whatever the
+// earlier stages wrote to the outputs. Runs last so neither the test tone's
+// channel copies nor the monitor fan-out can overwrite it.
+class VoicePoolNode : public AudioEngine::Node
+{
+public:
+    explicit VoicePoolNode (VoicePool& poolToUse) : pool (poolToUse) {}
+
+    void prepare (const AudioEngine::PrepareSpec& spec) override
+    {
+        numOutputChannels = spec.numOutputChannels;
+        pool.prepare (spec.sampleRate, spec.maxBlockSize);
+    }
+
+    void process (AudioEngine::ProcessContext& context) override
+    {
+        if (pool.getNumActiveVoices() == 0)
+            return;
+
+        pool.renderBlock (context.buffer, context.startSample, context.numSamples,
+                          numOutputChannels,
+                          context.outputGainStart, context.outputGainEnd);
+
+        if (context.buffer.getNumChannels() > 0)
+        {
+            auto range = juce::FloatVectorOperations::findMinAndMax (
+                context.buffer.getReadPointer (0, context.startSample), context.numSamples);
+            context.outputPeak = juce::jmax (context.outputPeak,
+                                             -range.getStart(), range.getEnd());
+        }
+    }
+
+    void release() override {}
+
+private:
+    VoicePool& pool;
+    int numOutputChannels = 0;
+};
+
+//==============================================================================
 AudioEngine::AudioEngine()
 {
+    // The graph is fixed for now: input analysis, then the synthesis and
+    // monitoring stages that write to the outputs. Agent voices slot in here
+    // later without the device callback changing.
+    chordDetector.setPublisher (&analysisPublisher);
+
+    nodes.add (new InputConditionerNode (inputConditioner));
+    nodes.add (new MeteringNode (meterBank, activityMap));
+    nodes.add (new InputStageNode (meterBank, activityMap));
+    nodes.add (new AnalysisNode (chordDetector, workerPool));
+    nodes.add (new WaveformTapNode (waveformHistory, workerPool));
+    nodes.add (new RecorderNode (recorder));
+    nodes.add (new ShmPublishNode (shmBus, meterBank, chordDetector));
+    nodes.add (new LatencyProbeNode (latencyProbe));
+    nodes.add (new TestToneNode());
+    nodes.add (new MonitorNode (routingMatrix));
+    nodes.add (new VoicePoolNode (voicePool));
 }
 
 AudioEngine::~AudioEngine()
 {
+    release();
 }
 
-void AudioEngine::prepare (int samplesPerBlock, double sampleRate)
+void AudioEngine::prepare (int samplesPerBlock, double sampleRate,
+                           int numInputChannels, int numOutputChannels)
 {
-    // Prepare any DSP here
+    currentSpec.sampleRate = sampleRate;
+    currentSpec.maxBlockSize = samplesPerBlock;
+    currentSpec.numInputChannels = numInputChannels;
+    currentSpec.numOutputChannels = numOutputChannels;
+
+    outputGainSmoothed.reset (sampleRate, 0.02);
+
+    // Workers come up before the nodes so the stages they service never see
+    // a submit() with nobody to run it. start() is a no-op when running.
+    workerPool.start();
+
+    for (auto* node : nodes)
+        node->prepare (currentSpec);
+
+    // Force a re-apply on the first block: node prepares reset the state the
+    // snapshot feeds (conditioner gains, routes)
+    appliedConfig = nullptr;
+
+    prepared = true;
 }
 
-void AudioEngine::process (juce::AudioBuffer<float>& buffer)
+void AudioEngine::process (juce::AudioBuffer<float>& buffer, int startSample,
+                           int numSamples, const EngineState& state)
 {
-    // Process audio
-    auto numChannels = buffer.getNumChannels();
-    auto numSamples = buffer.getNumSamples();
-    
-    // Apply gain
-    for (int channel = 0; channel < numChannels; ++channel)
+    if (! prepared)
+        return;
+
+    // Hot-reloaded profile: one acquire load per block; settings are pushed
+    // into the graph only on the block where the watcher swapped the pointer
+    if (const auto* snapshot = configStore.getSnapshot())
+    {
+        if (snapshot != appliedConfig)
+        {
+            applyConfigSnapshot (*snapshot);
+            appliedConfig = snapshot;
+        }
+    }
+
+    EngineState smoothedState = state;
+
+    // Apply control events queued by the OSC bridge. Note events trigger
+    // voices in the native pool; everything else tweaks control state.
+    OscEvent event;
+    while (oscQueue.pop (event))
     {
-        auto* channelData = buffer.getWritePointer (channel);
-        
-        for (int sample = 0; sample < numSamples; ++sample)
+        // Mapped-ring store, so logging from the callback is allocation-free
+        flightRecorder.log (FlightRecorder::EventType::oscEvent,
+                            (int) event.type, event.value1, event.value2);
+
+        switch (event.type)
         {
-            channelData[sample] *= outputVolume;
+            case OscEvent::Type::gain:
+                remoteGainScale = juce::jlimit (0.0f, 2.0f, event.value1);
+                break;
+            case OscEvent::Type::channel:
+                remoteChannelOverride = (int) event.value1;
+                break;
+            case OscEvent::Type::route:
+                routingMatrix.setRouteGain ((int) event.value1, (int) event.value2,
+                                            event.value3);
+                break;
+            case OscEvent::Type::note:
+                voicePool.noteOn ((int) event.value3, event.value1, event.value2);
+                break;
         }
     }
+
+    smoothedState.outputGain *= remoteGainScale;
+    if (remoteChannelOverride >= 0)
+        smoothedState.selectedInputChannel = remoteChannelOverride;
+
+    // Pop this block's pedal events. They were stamped against the engine
+    // clock the moment they arrived, so everything queued is due by the end
+    // of this block; the segment loop below applies each one on its sample.
+    PedalEvent pedalEvents[maxPedalEventsPerBlock];
+    int numPedalEvents = 0;
+    {
+        PedalEvent pedalEvent;
+        while (numPedalEvents < maxPedalEventsPerBlock && pedalQueue.pop (pedalEvent))
+            pedalEvents[numPedalEvents++] = pedalEvent;
+    }
+
+    const juce::int64 blockStart = samplePosition.load (std::memory_order_relaxed);
+
+    float blockInputPeak = 0.0f, blockOutputPeak = 0.0f;
+    int segmentStart = 0, nextEvent = 0;
+
+    while (segmentStart < numSamples)
+    {
+        // Apply everything due at or before the current position
+        while (nextEvent < numPedalEvents
+                && pedalEvents[nextEvent].sampleTimestamp <= blockStart + segmentStart)
+            applyPedalEvent (pedalEvents[nextEvent++]);
+
+        int segmentEnd = numSamples;
+        if (nextEvent < numPedalEvents)
+            segmentEnd = juce::jlimit (segmentStart + 1, numSamples,
+                                       (int) (pedalEvents[nextEvent].sampleTimestamp - blockStart));
+
+        EngineState segmentState = smoothedState;
+        if (pedalSustainDown)
+            segmentState.inputMonitoring = true;     // Sustain = listen/monitor
+        segmentState.outputGain *= pedalExpression;
+
+        processSegment (buffer, startSample + segmentStart, segmentEnd - segmentStart,
+                        segmentState, blockStart + segmentStart,
+                        blockInputPeak, blockOutputPeak);
+
+        segmentStart = segmentEnd;
+    }
+
+    inputLevel.store (blockInputPeak, std::memory_order_relaxed);
+    outputLevel.store (blockOutputPeak, std::memory_order_relaxed);
+
+    samplePosition.fetch_add (numSamples, std::memory_order_relaxed);
 }
 
-void AudioEngine::release()
+void AudioEngine::processSegment (juce::AudioBuffer<float>& buffer, int startSample,
+                                  int numSamples, const EngineState& state,
+                                  juce::int64 segmentPosition,
+                                  float& inputPeakOut, float& outputPeakOut)
 {
-    // Clean up
+    ProcessContext context { buffer, startSample, numSamples, state };
+    context.samplePosition = segmentPosition;
+
+    // Advance the 20ms output gain ramp by one segment and hand the
+    // endpoints to the nodes, which apply them block-wise
+    outputGainSmoothed.setTargetValue (state.outputGain);
+
+    context.outputGainStart = outputGainSmoothed.getCurrentValue();
+    outputGainSmoothed.skip (numSamples);
+    context.outputGainEnd = outputGainSmoothed.getCurrentValue();
+
+    for (auto* node : nodes)
+        node->process (context);
+
+    inputPeakOut = juce::jmax (inputPeakOut, context.inputPeak);
+    outputPeakOut = juce::jmax (outputPeakOut, context.outputPeak);
+}
+
+void AudioEngine::applyPedalEvent (const PedalEvent& event)
+{
+    flightRecorder.log (FlightRecorder::EventType::pedalEvent,
+                        event.controller, (float) event.value);
+
+    switch (event.controller)
+    {
+        case PedalEvent::sustainController:
+            pedalSustainDown = event.value >= 64;
+            break;
+
+        case PedalEvent::modeChangeController:
+            if (event.value >= 64)   // Rising edge only; release sends 0
+                pedalMode.fetch_add (1, std::memory_order_relaxed);
+            break;
+
+        case PedalEvent::expressionController:
+            pedalExpression = (float) event.value * (1.0f / 127.0f);
+            break;
+
+        case PedalEvent::tapTempoController:
+            // Consumed by the tempo tracker once the beat stage lands
+            break;
+    }
 }
 
-void AudioEngine::setInputGain (float gain)
+void AudioEngine::applyConfigSnapshot (const ConfigStore::Snapshot& snapshot)
 {
-    inputGain = gain;
+    // Everything below lands in per-route/per-channel atomics, so pushing a
+    // whole snapshot from the callback is a few thousand plain stores at
+    // worst - and it only happens on the block where a save was picked up.
+    // Sections the profile didn't set stay exactly as the UI left them, so
+    // an absent profile (and the re-apply after every prepare()) is a no-op.
+    if (snapshot.hasGateThreshold)
+        inputConditioner.setGateThreshold (snapshot.gateThreshold);
+
+    for (int channel = 0; channel < snapshot.numChannelGains; ++channel)
+        inputConditioner.setChannelGain (channel, snapshot.channelGains[channel]);
+
+    if (snapshot.hasRouting)
+    {
+        routingMatrix.clearAllRoutes();
+
+        for (int i = 0; i < snapshot.numRoutes; ++i)
+        {
+            const auto& route = snapshot.routes[i];
+            routingMatrix.setRouteGain (route.input, route.output, route.gain);
+        }
+    }
 }
 
-void AudioEngine::setOutputVolume (float volume)
+void AudioEngine::release()
 {
-    outputVolume = volume;
+    if (! prepared)
+        return;
+
+    // Stop the workers first: prepare() resets the analysis stages' state,
+    // which must not happen under a job still chewing on the old stream
+    workerPool.stop();
+
+    for (auto* node : nodes)
+        node->release();
+
+    prepared = false;
 }
@@ -1,28 +1,229 @@
 #pragma once
 
-#include <JuceHeader.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Metering.h"
+#include "ChannelActivityMap.h"
+#include "OscEvents.h"
+#include "PedalEvents.h"
+#include "ChordDetector.h"
+#include "Recorder.h"
+#include "RoutingMatrix.h"
+#include "SharedMemoryBus.h"
+#include "VoicePool.h"
+#include "WaveformHistory.h"
+#include "LatencyProbe.h"
+#include "WorkerPool.h"
+#include "FlightRecorder.h"
+#include "AnalysisPublisher.h"
+#include "InputConditioner.h"
+#include "ConfigStore.h"
 
+//==============================================================================
+/**
+    Per-block control values handed to the engine by the audio callback.
+
+    The caller fills this once per block; nothing inside the engine touches
+    UI components or locks.
+*/
+struct EngineState
+{
+    int selectedInputChannel = 0;
+    float outputGain = 0.75f;
+    double testToneFrequency = 440.0;
+    bool testToneActive = false;
+    bool inputMonitoring = false;
+};
+
+//==============================================================================
+/**
+    The real-time processing graph.
+
+    The engine owns an ordered list of processing nodes, each with the usual
+    prepare/process/release lifecycle. All buffers are allocated in prepare();
+    process() performs no allocation and takes no locks, so it is safe to call
+    from the device callback at 64-sample buffers.
+*/
 class AudioEngine
 {
 public:
+    //==============================================================================
+    /** Everything a node needs to size its internal state up front. */
+    struct PrepareSpec
+    {
+        double sampleRate = 48000.0;
+        int maxBlockSize = 512;
+        int numInputChannels = 2;
+        int numOutputChannels = 2;
+    };
+
+    /** Per-block context passed down the node chain.
+
+        Nodes communicate downstream through this struct rather than through
+        shared members, e.g. the input stage publishes which channel actually
+        carries signal so the monitor node can route it.
+    */
+    struct ProcessContext
+    {
+        juce::AudioBuffer<float>& buffer;
+        int startSample;
+        int numSamples;
+        const EngineState& state;
+
+        // Engine sample clock at the start of this block
+        juce::int64 samplePosition = 0;
+
+        // Filled in by the input stage, consumed further down the chain
+        int activeInputChannel = -1;
+        float inputPeak = 0.0f;
+        float outputPeak = 0.0f;
+
+        // Per-block output gain ramp from the engine's SmoothedValue; nodes
+        // apply it once per block per channel instead of multiplying per
+        // sample. Input gain is per channel now and lives in the conditioner.
+        float outputGainStart = 1.0f, outputGainEnd = 1.0f;
+    };
+
+    /** Base class for one stage of the graph. */
+    class Node
+    {
+    public:
+        virtual ~Node() = default;
+
+        virtual void prepare (const PrepareSpec& spec) = 0;
+        virtual void process (ProcessContext& context) = 0;
+        virtual void release() = 0;
+    };
+
+    //==============================================================================
     AudioEngine();
     ~AudioEngine();
-    
-    void prepare (int samplesPerBlock, double sampleRate);
-    void process (juce::AudioBuffer<float>& buffer);
+
+    void prepare (int samplesPerBlock, double sampleRate,
+                  int numInputChannels, int numOutputChannels);
+    void process (juce::AudioBuffer<float>& buffer, int startSample,
+                  int numSamples, const EngineState& state);
     void release();
-    
-    void setInputGain (float gain);
-    void setOutputVolume (float volume);
-    
-    float getInputLevel() const { return inputLevel; }
-    float getOutputLevel() const { return outputLevel; }
-    
+
+    float getInputLevel() const  { return inputLevel.load (std::memory_order_relaxed); }
+    float getOutputLevel() const { return outputLevel.load (std::memory_order_relaxed); }
+
+    /** Per-channel peak/RMS levels, readable from the message thread. */
+    const LevelMeterBank& getMeters() const { return meterBank; }
+
+    /** Per-channel gain, DC removal and gate; runs first in the graph. */
+    InputConditioner& getInputConditioner() { return inputConditioner; }
+
+    /** Channel-activity tracking; the message thread drains its notifications. */
+    ChannelActivityMap& getActivityMap() { return activityMap; }
+
+    /** Queue the OSC bridge pushes control events into; drained in process(). */
+    OscEventQueue& getOscEventQueue() { return oscQueue; }
+
+    /** Queue the MIDI pedal input pushes CC events into. The engine splits
+        its block at their timestamps, so pedal changes land on the sample.
+    */
+    PedalEventQueue& getPedalEventQueue() { return pedalQueue; }
+
+    /** Listening-mode counter advanced by the mode pedal (CC65); the UI and
+        the Python side interpret it modulo their mode list.
+    */
+    int getPedalMode() const { return pedalMode.load (std::memory_order_relaxed); }
+
+    /** Chord analysis stage fed from the active input channel. */
+    ChordDetector& getChordDetector() { return chordDetector; }
+
+    /** Batched OSC output: one bundle per analysis hop to the agent system. */
+    AnalysisPublisher& getAnalysisPublisher() { return analysisPublisher; }
+
+    /** Multi-channel input capture to a memory-mapped ring file. */
+    Recorder& getRecorder() { return recorder; }
+
+    /** Shared-memory segment the Python agents poll for audio and analysis. */
+    SharedMemoryBus& getSharedMemoryBus() { return shmBus; }
+
+    /** Native agent synthesis voices, triggered by OSC note events. */
+    VoicePool& getVoicePool() { return voicePool; }
+
+    /** Decimated waveform history of the active input, for the GUI. */
+    WaveformHistory& getWaveformHistory() { return waveformHistory; }
+
+    /** Loopback round-trip latency measurement. */
+    LatencyProbe& getLatencyProbe() { return latencyProbe; }
+
+    /** Shared analysis workers; every per-block analysis job runs here
+        instead of on a thread of its own.
+    */
+    WorkerPool& getWorkerPool() { return workerPool; }
+
+    /** Binary session log; the engine records OSC and pedal events into it,
+        the UI everything else.
+    */
+    FlightRecorder& getFlightRecorder() { return flightRecorder; }
+
+    /** Monitor routing table; when no routes are set the monitor falls back
+        to fanning the active input channel out to every output.
+    */
+    RoutingMatrix& getRoutingMatrix() { return routingMatrix; }
+
+    /** Hot-reloadable profile; process() re-applies it whenever the watcher
+        publishes a new snapshot. The profile wins over the UI on reload.
+    */
+    ConfigStore& getConfigStore() { return configStore; }
+
+    /** Engine sample clock, for timestamping events against the audio stream. */
+    juce::int64 getSamplePosition() const { return samplePosition.load (std::memory_order_relaxed); }
+
 private:
-    float inputGain = 0.5f;
-    float outputVolume = 0.75f;
-    float inputLevel = 0.0f;
-    float outputLevel = 0.0f;
-    
+    static constexpr int maxPedalEventsPerBlock = 32;
+
+    void processSegment (juce::AudioBuffer<float>& buffer, int startSample,
+                         int numSamples, const EngineState& state,
+                         juce::int64 segmentPosition,
+                         float& inputPeakOut, float& outputPeakOut);
+    void applyPedalEvent (const PedalEvent& event);
+    void applyConfigSnapshot (const ConfigStore::Snapshot& snapshot);
+
+    InputConditioner inputConditioner;
+    LevelMeterBank meterBank;
+    ChannelActivityMap activityMap;
+    AnalysisPublisher analysisPublisher { meterBank };
+    ChordDetector chordDetector;
+    Recorder recorder;
+    RoutingMatrix routingMatrix;
+    SharedMemoryBus shmBus;
+    VoicePool voicePool;
+    WaveformHistory waveformHistory;
+    LatencyProbe latencyProbe;
+    WorkerPool workerPool;
+    FlightRecorder flightRecorder;
+    ConfigStore configStore;
+    juce::OwnedArray<Node> nodes;
+    PrepareSpec currentSpec;
+    bool prepared = false;
+
+    // Ramped output gain: 20ms smoothing so fader rides are zipper-free,
+    // applied block-wise by the nodes via applyGainRamp rather than per
+    // sample. The per-channel input gains ramp inside the conditioner.
+    juce::SmoothedValue<float> outputGainSmoothed;
+
+    // Pedal state driven by the MIDI input thread's queue. Audio thread only.
+    PedalEventQueue pedalQueue;
+    bool pedalSustainDown = false;
+    float pedalExpression = 1.0f;
+    std::atomic<int> pedalMode { 0 };
+
+    // Remote control state driven by the OSC bridge
+    OscEventQueue oscQueue;
+    std::atomic<juce::int64> samplePosition { 0 };
+    float remoteGainScale = 1.0f;
+    int remoteChannelOverride = -1;
+
+    std::atomic<float> inputLevel { 0.0f };
+    std::atomic<float> outputLevel { 0.0f };
+
+    // Last config snapshot applied to the graph; pointer compare only, the
+    // store keeps the pointee alive well past any block that could read it
+    const ConfigStore::Snapshot* appliedConfig = nullptr;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioEngine)
 };
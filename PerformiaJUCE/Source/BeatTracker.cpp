@@ -0,0 +1,119 @@
+#include "BeatTracker.h"
+
+//==============================================================================
+BeatTracker::BeatTracker()
+{
+    juce::FloatVectorOperations::clear (previousMagnitudes, maxBins);
+    juce::FloatVectorOperations::clear (onsetEnvelope, envelopeSize);
+}
+
+void BeatTracker::prepare (double sampleRateToUse, int hopSizeToUse)
+{
+    hopSeconds = (double) hopSizeToUse / sampleRateToUse;
+
+    juce::FloatVectorOperations::clear (previousMagnitudes, maxBins);
+    juce::FloatVectorOperations::clear (onsetEnvelope, envelopeSize);
+    envelopeWrite = 0;
+    hopsSinceTempoUpdate = 0;
+    beatPeriodHops = 0.0;
+    phase = 0.0;
+    previousFlux = 0.0f;
+
+    tempoBpm.store (0.0f, std::memory_order_relaxed);
+    beatPhase.store (0.0f, std::memory_order_relaxed);
+}
+
+//==============================================================================
+bool BeatTracker::processSpectrum (const float* magnitudes, int numBins)
+{
+    numBins = juce::jmin (numBins, (int) maxBins);
+
+    // Half-wave rectified spectral flux against the previous hop's spectrum
+    float flux = 0.0f;
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const float difference = magnitudes[bin] - previousMagnitudes[bin];
+        if (difference > 0.0f)
+            flux += difference;
+    }
+    juce::FloatVectorOperations::copy (previousMagnitudes, magnitudes, numBins);
+
+    onsetEnvelope[envelopeWrite] = flux;
+    envelopeWrite = (envelopeWrite + 1) & (envelopeSize - 1);
+
+    // Adaptive threshold: mean of the last 16 hops, with a margin. An onset
+    // is a flux peak clearing it on a rising edge.
+    float recentMean = 0.0f;
+    for (int i = 1; i <= 16; ++i)
+        recentMean += onsetEnvelope[(envelopeWrite - 1 - i) & (envelopeSize - 1)];
+    recentMean *= (1.0f / 16.0f);
+
+    const bool onset = flux > 1.5f * recentMean + 1.0e-4f && flux > previousFlux;
+    previousFlux = flux;
+
+    if (++hopsSinceTempoUpdate >= 32)
+    {
+        hopsSinceTempoUpdate = 0;
+        updateTempo();
+    }
+
+    // Beat phase: free-run at the estimated period, resynchronize when an
+    // onset lands near the predicted beat
+    if (beatPeriodHops > 1.0)
+    {
+        phase += 1.0 / beatPeriodHops;
+        if (phase >= 1.0)
+            phase -= 1.0;
+
+        if (onset && (phase < 0.15 || phase > 0.85))
+            phase = 0.0;
+    }
+
+    beatPhase.store ((float) phase, std::memory_order_relaxed);
+
+    if (onset)
+        onsetCount.fetch_add (1, std::memory_order_relaxed);
+
+    return onset;
+}
+
+void BeatTracker::updateTempo()
+{
+    // Autocorrelation of the onset envelope over the 60-180 BPM lag range.
+    // 32 hops between updates keeps this incremental: ~130 lags x 256 terms.
+    const int minLag = juce::jmax (1, (int) ((60.0 / 180.0) / hopSeconds));
+    const int maxLag = juce::jmin (envelopeSize / 2, (int) ((60.0 / 60.0) / hopSeconds));
+    constexpr int windowHops = 256;
+
+    int bestLag = 0;
+    float bestCorrelation = 0.0f;
+
+    for (int lag = minLag; lag <= maxLag; ++lag)
+    {
+        float correlation = 0.0f;
+        for (int i = 0; i < windowHops; ++i)
+        {
+            const float a = onsetEnvelope[(envelopeWrite - 1 - i) & (envelopeSize - 1)];
+            const float b = onsetEnvelope[(envelopeWrite - 1 - i - lag) & (envelopeSize - 1)];
+            correlation += a * b;
+        }
+
+        if (correlation > bestCorrelation)
+        {
+            bestCorrelation = correlation;
+            bestLag = lag;
+        }
+    }
+
+    if (bestLag <= 0 || bestCorrelation <= 0.0f)
+        return;
+
+    // Smooth towards the new estimate so a single noisy window can't yank
+    // the agents' clock around
+    const double newPeriod = (double) bestLag;
+    beatPeriodHops = beatPeriodHops > 1.0 ? 0.8 * beatPeriodHops + 0.2 * newPeriod
+                                          : newPeriod;
+
+    tempoBpm.store ((float) (60.0 / (beatPeriodHops * hopSeconds)),
+                    std::memory_order_relaxed);
+}
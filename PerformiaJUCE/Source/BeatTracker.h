@@ -0,0 +1,57 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Onset and tempo tracking for the Rhythmic Sync listening mode.
+
+    Runs on the chord detector's analysis thread and is fed the magnitude
+    spectrum that thread already computed, so the whole rhythm stage costs
+    zero extra FFTs: onsets come from half-wave-rectified spectral flux with
+    an adaptive threshold, tempo from an incremental autocorrelation over the
+    onset envelope, and beat phase from a predicted-period counter that
+    resynchronizes on onsets landing near the prediction. Results are
+    published through atomics; the engine mirrors them onto the
+    shared-memory bus for the Python agents.
+*/
+class BeatTracker
+{
+public:
+    static constexpr int maxBins = 1024;        // fftSize / 2 upstream
+    static constexpr int envelopeSize = 512;    // ~2.7s of hops at 48k/256
+
+    BeatTracker();
+
+    void prepare (double sampleRateToUse, int hopSizeToUse);
+
+    /** Analysis thread: consumes one hop's magnitude spectrum.
+        Returns true if this hop contained an onset.
+    */
+    bool processSpectrum (const float* magnitudes, int numBins);
+
+    //==============================================================================
+    // Message-thread / engine readers
+    float getTempoBpm() const   { return tempoBpm.load (std::memory_order_relaxed); }
+    float getBeatPhase() const  { return beatPhase.load (std::memory_order_relaxed); }
+    juce::uint32 getOnsetCount() const { return onsetCount.load (std::memory_order_relaxed); }
+
+private:
+    void updateTempo();
+
+    float previousMagnitudes[maxBins];
+    float onsetEnvelope[envelopeSize];
+    int envelopeWrite = 0;
+    int hopsSinceTempoUpdate = 0;
+
+    double hopSeconds = 256.0 / 48000.0;
+    double beatPeriodHops = 0.0;
+    double phase = 0.0;
+    float previousFlux = 0.0f;
+
+    std::atomic<float> tempoBpm { 0.0f };
+    std::atomic<float> beatPhase { 0.0f };
+    std::atomic<juce::uint32> onsetCount { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BeatTracker)
+};
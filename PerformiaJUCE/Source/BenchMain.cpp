@@ -0,0 +1,208 @@
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+
+#include "AudioEngine.h"
+#include "Metering.h"
+#include "WavetableOscillator.h"
+
+#if defined (__x86_64__) || defined (_M_X64)
+ #include <x86intrin.h>
+#endif
+
+//==============================================================================
+/*
+    performia_bench: microbenchmarks for the audio hot path.
+
+    Runs the kernels the device callback actually executes - the metering
+    scan, test-tone synthesis, the full AudioEngine::process graph and the
+    chord detector's FFT frame - across the buffer sizes and channel counts
+    we deploy with, and reports ns/block and cycles/sample. Every change on
+    the optimization list gets validated here against the <15ms end-to-end
+    budget before it ships.
+*/
+
+namespace
+{
+
+//==============================================================================
+// Cycle counter: rdtsc on x86-64, the fixed-frequency virtual counter on
+// arm64. Both tick at a constant rate, which is what we want for ratios.
+inline juce::uint64 readCycleCounter()
+{
+   #if defined (__x86_64__) || defined (_M_X64)
+    return __rdtsc();
+   #elif defined (__aarch64__)
+    juce::uint64 value;
+    asm volatile ("mrs %0, cntvct_el0" : "=r" (value));
+    return value;
+   #else
+    return 0;
+   #endif
+}
+
+struct BenchResult
+{
+    double nsPerBlock = 0.0;
+    double cyclesPerSample = 0.0;
+};
+
+//==============================================================================
+// Runs the kernel with warmup, then takes the median of several repetitions
+// so a stray scheduler preemption doesn't pollute the numbers.
+template <typename Kernel>
+BenchResult runBenchmark (Kernel&& kernel, int samplesPerBlock)
+{
+    constexpr int warmupIterations = 100;
+    constexpr int repetitions = 9;
+    constexpr int iterationsPerRep = 500;
+
+    for (int i = 0; i < warmupIterations; ++i)
+        kernel();
+
+    std::vector<double> nsPerBlock, cyclesPerBlock;
+    nsPerBlock.reserve (repetitions);
+    cyclesPerBlock.reserve (repetitions);
+
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        const auto startCycles = readCycleCounter();
+
+        for (int i = 0; i < iterationsPerRep; ++i)
+            kernel();
+
+        const auto elapsedCycles = readCycleCounter() - startCycles;
+        const auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds> (
+                                   std::chrono::steady_clock::now() - startTime).count();
+
+        nsPerBlock.push_back ((double) elapsedNs / iterationsPerRep);
+        cyclesPerBlock.push_back ((double) elapsedCycles / iterationsPerRep);
+    }
+
+    std::sort (nsPerBlock.begin(), nsPerBlock.end());
+    std::sort (cyclesPerBlock.begin(), cyclesPerBlock.end());
+
+    BenchResult result;
+    result.nsPerBlock = nsPerBlock[repetitions / 2];
+    result.cyclesPerSample = cyclesPerBlock[repetitions / 2] / samplesPerBlock;
+    return result;
+}
+
+void printResult (const char* name, int bufferSize, int numChannels,
+                  const BenchResult& result)
+{
+    std::printf ("%-28s %4d smp  %2d ch   %10.0f ns/block   %8.2f cyc/smp\n",
+                 name, bufferSize, numChannels,
+                 result.nsPerBlock, result.cyclesPerSample);
+}
+
+void fillWithNoise (juce::AudioBuffer<float>& buffer)
+{
+    juce::Random random (42);
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+}
+
+} // namespace
+
+//==============================================================================
+int main()
+{
+    constexpr double sampleRate = 48000.0;
+    const int bufferSizes[] = { 32, 64, 128, 256 };
+    const int channelCounts[] = { 2, 8, 26, 64 };
+
+    std::printf ("performia_bench @ %.0f Hz (median of 9 reps x 500 iterations)\n\n",
+                 sampleRate);
+
+    //==============================================================================
+    // Metering scan
+    for (int numChannels : channelCounts)
+    {
+        for (int bufferSize : bufferSizes)
+        {
+            LevelMeterBank bank;
+            bank.prepare (numChannels);
+
+            juce::AudioBuffer<float> buffer (numChannels, bufferSize);
+            fillWithNoise (buffer);
+
+            auto result = runBenchmark ([&] { bank.measureBlock (buffer, 0, bufferSize); },
+                                        bufferSize);
+            printResult ("metering scan", bufferSize, numChannels, result);
+        }
+    }
+    std::printf ("\n");
+
+    //==============================================================================
+    // Test-tone synthesis (single channel; the engine block-copies the rest)
+    for (int bufferSize : bufferSizes)
+    {
+        WavetableOscillator oscillator;
+        oscillator.prepare (sampleRate);
+        oscillator.setFrequency (440.0);
+
+        juce::AudioBuffer<float> buffer (1, bufferSize);
+
+        auto result = runBenchmark ([&]
+        {
+            oscillator.renderBlock (buffer.getWritePointer (0), bufferSize, 0.3f);
+        }, bufferSize);
+        printResult ("test-tone synthesis", bufferSize, 1, result);
+    }
+    std::printf ("\n");
+
+    //==============================================================================
+    // Full engine graph: what the device callback actually pays per block
+    for (int numChannels : channelCounts)
+    {
+        for (int bufferSize : bufferSizes)
+        {
+            AudioEngine engine;
+            engine.prepare (bufferSize, sampleRate, numChannels, 2);
+
+            juce::AudioBuffer<float> buffer (juce::jmax (numChannels, 2), bufferSize);
+            fillWithNoise (buffer);
+
+            EngineState state;
+            state.inputMonitoring = true;
+
+            auto result = runBenchmark ([&]
+            {
+                engine.process (buffer, 0, bufferSize, state);
+            }, bufferSize);
+            printResult ("engine process (monitor)", bufferSize, numChannels, result);
+
+            engine.release();
+        }
+    }
+    std::printf ("\n");
+
+    //==============================================================================
+    // Chord-detector FFT frame (2048-point, runs every 256-sample hop)
+    {
+        constexpr int fftOrder = 11;
+        constexpr int fftSize = 1 << fftOrder;
+
+        juce::dsp::FFT fft (fftOrder);
+        juce::HeapBlock<float> fftData (2 * fftSize, true);
+
+        juce::Random random (42);
+        for (int i = 0; i < fftSize; ++i)
+            fftData[i] = random.nextFloat() * 2.0f - 1.0f;
+
+        auto result = runBenchmark ([&]
+        {
+            fft.performFrequencyOnlyForwardTransform (fftData.getData());
+        }, fftSize);
+        printResult ("chord FFT frame", fftSize, 1, result);
+    }
+
+    return 0;
+}
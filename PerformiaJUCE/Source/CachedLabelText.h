@@ -0,0 +1,47 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+//==============================================================================
+/**
+    Allocation-free label formatting for the status UI.
+
+    The 30ms timer used to rebuild several juce::Strings per tick just to
+    set text that almost never changes - heap churn on the message thread
+    for nothing. This renders printf-style into a fixed stack buffer,
+    compares against the previously applied text, and only touches the
+    Label (and only then pays for a juce::String) when the rendered text
+    actually differs. At steady state a tick allocates nothing.
+*/
+class CachedLabelText
+{
+public:
+    static constexpr int capacity = 160;
+
+    /** Renders and applies the text if it changed; returns true when it did,
+        so callers can gate colour changes and the like on the same edge.
+    */
+    bool update (juce::Label& label, const char* format, ...)
+    {
+        char rendered[capacity];
+
+        va_list args;
+        va_start (args, format);
+        std::vsnprintf (rendered, sizeof (rendered), format, args);
+        va_end (args);
+
+        if (std::strcmp (rendered, previous) == 0)
+            return false;
+
+        std::strcpy (previous, rendered);
+        label.setText (juce::String (juce::CharPointer_UTF8 (previous)),
+                       juce::dontSendNotification);
+        return true;
+    }
+
+private:
+    char previous[capacity] = { 0 };
+};
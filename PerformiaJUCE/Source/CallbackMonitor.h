@@ -0,0 +1,100 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <chrono>
+
+//==============================================================================
+/**
+    Lightweight instrumentation for the audio callback.
+
+    beginBlock()/endBlock() wrap the processing in getNextAudioBlock and record
+    per-callback duration, DSP load as a fraction of the buffer period, an
+    xrun counter (callbacks that overran the period), and a histogram of
+    callback times - everything in lock-free atomics so the timer-driven UI
+    can show a 99th-percentile callback time without touching the audio
+    thread. Two steady_clock reads per block is the entire hot-path cost.
+*/
+class CallbackMonitor
+{
+public:
+    static constexpr int numHistogramBuckets = 128;
+
+    void prepare (double sampleRate, int bufferSize)
+    {
+        bufferPeriodSeconds = bufferSize / juce::jmax (1.0, sampleRate);
+
+        // Histogram spans [0, 2x period] so overruns are still binned
+        bucketWidthSeconds = (2.0 * bufferPeriodSeconds) / numHistogramBuckets;
+
+        for (auto& bucket : histogram)
+            bucket.store (0, std::memory_order_relaxed);
+
+        xrunCount.store (0, std::memory_order_relaxed);
+        lastLoad.store (0.0f, std::memory_order_relaxed);
+        totalBlocks.store (0, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    // Audio thread
+    void beginBlock()
+    {
+        blockStart = std::chrono::steady_clock::now();
+    }
+
+    void endBlock()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - blockStart;
+        const double seconds = std::chrono::duration<double> (elapsed).count();
+
+        lastCallbackSeconds.store ((float) seconds, std::memory_order_relaxed);
+        lastLoad.store ((float) (seconds / bufferPeriodSeconds), std::memory_order_relaxed);
+
+        if (seconds > bufferPeriodSeconds)
+            xrunCount.fetch_add (1, std::memory_order_relaxed);
+
+        int bucket = bucketWidthSeconds > 0.0 ? (int) (seconds / bucketWidthSeconds) : 0;
+        bucket = juce::jlimit (0, numHistogramBuckets - 1, bucket);
+        histogram[bucket].fetch_add (1, std::memory_order_relaxed);
+        totalBlocks.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    // Message-thread readers
+    float getLastCallbackMs() const { return lastCallbackSeconds.load (std::memory_order_relaxed) * 1000.0f; }
+    float getLastLoad() const       { return lastLoad.load (std::memory_order_relaxed); }
+    juce::uint32 getXRunCount() const { return xrunCount.load (std::memory_order_relaxed); }
+
+    /** Walks the histogram to find the given percentile callback time in ms. */
+    float getPercentileMs (double percentile) const
+    {
+        const juce::uint64 total = totalBlocks.load (std::memory_order_relaxed);
+        if (total == 0)
+            return 0.0f;
+
+        const auto target = (juce::uint64) (percentile * (double) total);
+        juce::uint64 seen = 0;
+
+        for (int i = 0; i < numHistogramBuckets; ++i)
+        {
+            seen += histogram[i].load (std::memory_order_relaxed);
+            if (seen >= target)
+                return (float) ((i + 1) * bucketWidthSeconds * 1000.0);
+        }
+
+        return (float) (2.0 * bufferPeriodSeconds * 1000.0);
+    }
+
+private:
+    double bufferPeriodSeconds = 512.0 / 48000.0;
+    double bucketWidthSeconds = 0.0;
+
+    std::chrono::steady_clock::time_point blockStart;
+
+    std::atomic<float> lastCallbackSeconds { 0.0f };
+    std::atomic<float> lastLoad { 0.0f };
+    std::atomic<juce::uint32> xrunCount { 0 };
+    std::atomic<juce::uint64> totalBlocks { 0 };
+    std::atomic<juce::uint32> histogram[numHistogramBuckets];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackMonitor)
+};
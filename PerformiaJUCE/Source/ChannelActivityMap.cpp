@@ -0,0 +1,73 @@
+#include "ChannelActivityMap.h"
+
+ChannelActivityMap::ChannelActivityMap()
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+        activity[ch] = 0.0f;
+}
+
+void ChannelActivityMap::prepare (int numChannelsToTrack, double sampleRate, int blockSize)
+{
+    numChannels = juce::jmin (numChannelsToTrack, maxChannels);
+
+    // ~100ms release regardless of block size, so channel hand-off feels the
+    // same at 64 and 512 samples
+    const double blocksPer100ms = (0.1 * sampleRate) / juce::jmax (1, blockSize);
+    decayPerBlock = (float) std::exp (-1.0 / juce::jmax (1.0, blocksPer100ms));
+
+    for (int ch = 0; ch < maxChannels; ++ch)
+        activity[ch] = 0.0f;
+
+    bestChannel.store (-1, std::memory_order_relaxed);
+    lastNotifiedChannel = -1;
+}
+
+void ChannelActivityMap::updateFromMeters (const LevelMeterBank& meters)
+{
+    float bestActivity = activityThreshold;
+    int best = -1;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const float peak = meters.getBlockPeak (ch);
+        activity[ch] = juce::jmax (peak, activity[ch] * decayPerBlock);
+
+        if (activity[ch] > bestActivity)
+        {
+            bestActivity = activity[ch];
+            best = ch;
+        }
+    }
+
+    bestChannel.store (best, std::memory_order_relaxed);
+}
+
+void ChannelActivityMap::notifyFallback (int channel)
+{
+    if (channel == lastNotifiedChannel)
+        return;
+
+    lastNotifiedChannel = channel;
+
+    int start1, size1, start2, size2;
+    notificationFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 > 0)
+    {
+        notificationBuffer[start1] = channel;
+        notificationFifo.finishedWrite (1);
+    }
+}
+
+bool ChannelActivityMap::popNotification (int& channelOut)
+{
+    int start1, size1, start2, size2;
+    notificationFifo.prepareToRead (1, start1, size1, start2, size2);
+
+    if (size1 <= 0)
+        return false;
+
+    channelOut = notificationBuffer[start1];
+    notificationFifo.finishedRead (1);
+    return true;
+}
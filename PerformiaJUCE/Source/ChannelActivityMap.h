@@ -0,0 +1,57 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Metering.h"
+
+//==============================================================================
+/**
+    Incremental channel-activity tracking.
+
+    The old fallback path rescanned every input channel from the callback
+    whenever the selected channel went quiet - the worst case ran continuously
+    during quiet passages. Instead, the metering pass feeds a decaying
+    per-channel activity envelope here each block, the loudest active channel
+    is published through a single atomic, and "signal found on another
+    channel" events go to the message thread through a lock-free FIFO rather
+    than DBG logging from the audio thread.
+*/
+class ChannelActivityMap
+{
+public:
+    static constexpr int maxChannels = LevelMeterBank::maxChannels;
+
+    ChannelActivityMap();
+
+    void prepare (int numChannelsToTrack, double sampleRate, int blockSize);
+
+    /** Audio thread: folds this block's peaks into the decaying activity
+        envelopes and republishes the best channel.
+    */
+    void updateFromMeters (const LevelMeterBank& meters);
+
+    /** Audio thread: wait-free read of the current best channel (-1 if all quiet). */
+    int getBestChannel() const { return bestChannel.load (std::memory_order_relaxed); }
+
+    /** Audio thread: queues a fallback notification if this channel hasn't
+        been announced yet. Never blocks; drops if the FIFO is full.
+    */
+    void notifyFallback (int channel);
+
+    /** Message thread: pops one queued notification. Returns false when empty. */
+    bool popNotification (int& channelOut);
+
+private:
+    float activity[maxChannels];
+    float decayPerBlock = 0.9f;
+    int numChannels = 0;
+
+    std::atomic<int> bestChannel { -1 };
+
+    juce::AbstractFifo notificationFifo { 16 };
+    int notificationBuffer[16];
+    int lastNotifiedChannel = -1;
+
+    static constexpr float activityThreshold = 0.0001f;  // Matches "no signal" threshold
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelActivityMap)
+};
@@ -0,0 +1,195 @@
+#include "ChordDetector.h"
+
+namespace
+{
+    const char* const noteNames[12] = { "C", "C#", "D", "D#", "E", "F",
+                                        "F#", "G", "G#", "A", "A#", "B" };
+}
+
+ChordDetector::ChordDetector()
+{
+    for (int i = 0; i < fftSize; ++i)
+        window[i] = 0.5f - 0.5f * std::cos (2.0f * juce::MathConstants<float>::pi
+                                            * (float) i / (float) fftSize);
+
+    buildTemplates();
+
+    for (auto& bin : chroma)
+        bin = 0.0f;
+}
+
+void ChordDetector::buildTemplates()
+{
+    // Rows are L2-normalised pitch-class templates: root/third/fifth for
+    // major and minor triads, plus the flat seventh for dominant chords.
+    for (int root = 0; root < 12; ++root)
+    {
+        for (int i = 0; i < 12; ++i)
+        {
+            templates[root][i] = 0.0f;           // major
+            templates[root + 12][i] = 0.0f;      // minor
+            templates[root + 24][i] = 0.0f;      // dominant 7th
+        }
+
+        templates[root][root] = 1.0f;
+        templates[root][(root + 4) % 12] = 1.0f;
+        templates[root][(root + 7) % 12] = 1.0f;
+
+        templates[root + 12][root] = 1.0f;
+        templates[root + 12][(root + 3) % 12] = 1.0f;
+        templates[root + 12][(root + 7) % 12] = 1.0f;
+
+        templates[root + 24][root] = 1.0f;
+        templates[root + 24][(root + 4) % 12] = 1.0f;
+        templates[root + 24][(root + 7) % 12] = 1.0f;
+        templates[root + 24][(root + 10) % 12] = 1.0f;
+    }
+
+    for (int chord = 0; chord < numChords; ++chord)
+    {
+        float norm = 0.0f;
+        for (int i = 0; i < 12; ++i)
+            norm += templates[chord][i] * templates[chord][i];
+
+        norm = std::sqrt (norm);
+        for (int i = 0; i < 12; ++i)
+            templates[chord][i] /= norm;
+    }
+}
+
+const char* ChordDetector::getChordName (int chordIndex)
+{
+    static char nameBuffer[8];
+
+    if (chordIndex < 0 || chordIndex >= numChords)
+        return "-";
+
+    const int root = chordIndex % 12;
+    const char* quality = chordIndex < 12 ? "" : (chordIndex < 24 ? "m" : "7");
+    std::snprintf (nameBuffer, sizeof (nameBuffer), "%s%s", noteNames[root], quality);
+    return nameBuffer;
+}
+
+void ChordDetector::prepare (double sampleRateToUse)
+{
+    sampleRate = sampleRateToUse;
+    sampleFifo.reset();
+
+    // The sliding window must start silent: the first few hops analyse it
+    // before it has been fully refilled, and a device change must not leak
+    // the previous session's tail into the new one
+    juce::FloatVectorOperations::clear (analysisFrame, fftSize);
+
+    beatTracker.prepare (sampleRate, hopSize);
+    currentChord.store (-1, std::memory_order_relaxed);
+    currentConfidence.store (0.0f, std::memory_order_relaxed);
+}
+
+void ChordDetector::pushSamples (const float* samples, int numSamples)
+{
+    int start1, size1, start2, size2;
+    sampleFifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        juce::FloatVectorOperations::copy (sampleRing + start1, samples, size1);
+    if (size2 > 0)
+        juce::FloatVectorOperations::copy (sampleRing + start2, samples + size1, size2);
+
+    sampleFifo.finishedWrite (size1 + size2);
+}
+
+void ChordDetector::processPendingHops()
+{
+    while (sampleFifo.getNumReady() >= hopSize)
+    {
+        // Slide the analysis frame by one hop and append the new samples
+        std::memmove (analysisFrame, analysisFrame + hopSize,
+                      (size_t) (fftSize - hopSize) * sizeof (float));
+
+        int start1, size1, start2, size2;
+        sampleFifo.prepareToRead (hopSize, start1, size1, start2, size2);
+
+        float* dest = analysisFrame + (fftSize - hopSize);
+        if (size1 > 0)
+            juce::FloatVectorOperations::copy (dest, sampleRing + start1, size1);
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy (dest + size1, sampleRing + start2, size2);
+
+        sampleFifo.finishedRead (size1 + size2);
+
+        analyseFrame();
+    }
+}
+
+void ChordDetector::analyseFrame()
+{
+    // Window into the preallocated FFT workspace
+    juce::FloatVectorOperations::multiply (fftData, analysisFrame, window, fftSize);
+    juce::FloatVectorOperations::clear (fftData + fftSize, fftSize);
+
+    fft.performFrequencyOnlyForwardTransform (fftData);
+
+    // Rhythm stage first: it reuses this frame's magnitudes, so chord and
+    // onset analysis together still cost one transform per hop
+    const bool onset = beatTracker.processSpectrum (fftData, fftSize / 2);
+
+    // Fold magnitude bins between ~60Hz and ~5kHz into a chromagram
+    for (auto& bin : chroma)
+        bin = 0.0f;
+
+    const double binHz = sampleRate / (double) fftSize;
+    const int firstBin = juce::jmax (1, (int) (60.0 / binHz));
+    const int lastBin = juce::jmin (fftSize / 2, (int) (5000.0 / binHz));
+
+    for (int bin = firstBin; bin < lastBin; ++bin)
+    {
+        const double frequency = bin * binHz;
+        const double midiNote = 69.0 + 12.0 * std::log2 (frequency / 440.0);
+        const int pitchClass = ((int) std::lround (midiNote) % 12 + 12) % 12;
+        chroma[pitchClass] += fftData[bin];
+    }
+
+    float energy = 0.0f;
+    for (auto bin : chroma)
+        energy += bin * bin;
+
+    // Best match against the template matrix (normalised dot product);
+    // silence keeps the "no chord" result
+    int bestChord = -1;
+    float bestScore = 0.0f;
+
+    if (energy >= 1.0e-6f)
+    {
+        const float invNorm = 1.0f / std::sqrt (energy);
+
+        for (int chord = 0; chord < numChords; ++chord)
+        {
+            float score = 0.0f;
+            for (int i = 0; i < 12; ++i)
+                score += templates[chord][i] * chroma[i] * invNorm;
+
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestChord = chord;
+            }
+        }
+    }
+
+    const int previousChord = currentChord.exchange (bestChord, std::memory_order_relaxed);
+    currentConfidence.store (bestScore, std::memory_order_relaxed);
+
+    // Everything this hop produced goes out as one batched bundle
+    if (publisher != nullptr)
+    {
+        HopResult result;
+        result.chord = bestChord;
+        result.confidence = bestScore;
+        result.chordChanged = bestChord != previousChord;
+        result.onset = onset;
+        result.tempoBpm = beatTracker.getTempoBpm();
+        result.beatPhase = beatTracker.getBeatPhase();
+
+        publisher->publishHop (result);
+    }
+}
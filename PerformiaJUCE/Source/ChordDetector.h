@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "BeatTracker.h"
+#include "AnalysisPublisher.h"
+
+//==============================================================================
+/**
+    Native low-latency chord detection.
+
+    The audio callback pushes the active input channel into a lock-free FIFO
+    (one ring write per block, nothing else). A high-priority job on the
+    shared worker pool maintains a sliding window over that stream and, once
+    per hop, runs a Hann-windowed FFT, folds the spectrum into a 12-bin
+    chromagram, and matches it against a precomputed chord-template matrix.
+    All FFT workspaces are preallocated in prepare(). Results are published
+    through atomics for the UI and handed to the analysis publisher, which
+    batches each hop into one OSC bundle for the Python agents, replacing
+    the ~8ms librosa/sounddevice path with a 2-3ms in-process one.
+*/
+class ChordDetector
+{
+public:
+    static constexpr int fftOrder = 11;               // 2048-point FFT
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = 256;
+    static constexpr int numChords = 36;              // 12 major, 12 minor, 12 dominant 7th
+
+    ChordDetector();
+
+    void prepare (double sampleRateToUse);
+
+    /** Audio thread: feeds one block of the active input channel. Never blocks. */
+    void pushSamples (const float* samples, int numSamples);
+
+    /** Worker-pool job body: analyses every complete hop queued in the FIFO.
+        The engine guarantees one outstanding job at a time, so the sliding
+        window and FFT workspaces need no further guarding.
+    */
+    void processPendingHops();
+
+    //==============================================================================
+    // Message-thread / OSC readers
+    int getCurrentChord() const      { return currentChord.load (std::memory_order_relaxed); }
+    float getCurrentConfidence() const { return currentConfidence.load (std::memory_order_relaxed); }
+
+    static const char* getChordName (int chordIndex);
+
+    /** Onset/tempo stage sharing this detector's FFT frames - one transform
+        per hop covers both chord and rhythm analysis.
+    */
+    BeatTracker& getBeatTracker() { return beatTracker; }
+
+    /** Hop results go here - the batched OSC publisher live, a collecting
+        sink offline; unset means analyse-only (the UI atomics still update).
+    */
+    void setPublisher (AnalysisSink* publisherToUse) { publisher = publisherToUse; }
+
+private:
+    void analyseFrame();
+    void buildTemplates();
+
+    juce::dsp::FFT fft { fftOrder };
+    float window[fftSize];
+    float fftData[fftSize * 2];
+    float analysisFrame[fftSize];
+    float chroma[12];
+    float templates[numChords][12];
+    BeatTracker beatTracker;
+
+    // Callback -> analysis thread sample ring
+    static constexpr int ringSize = 1 << 15;
+    juce::AbstractFifo sampleFifo { ringSize };
+    float sampleRing[ringSize];
+
+    double sampleRate = 48000.0;
+    std::atomic<int> currentChord { -1 };
+    std::atomic<float> currentConfidence { 0.0f };
+
+    AnalysisSink* publisher = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChordDetector)
+};
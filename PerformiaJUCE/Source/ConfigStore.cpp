@@ -0,0 +1,144 @@
+#include "ConfigStore.h"
+#include "RoutingMatrix.h"
+
+ConfigStore::ConfigStore()
+    : juce::Thread ("Config Watcher")
+{
+}
+
+ConfigStore::~ConfigStore()
+{
+    close();
+}
+
+//==============================================================================
+void ConfigStore::open (const juce::File& profileFile)
+{
+    close();
+
+    file = profileFile;
+    lastModificationTime = file.getLastModificationTime();
+
+    if (auto snapshot = parseProfile())
+    {
+        publish (std::move (snapshot));
+    }
+    else
+    {
+        // Malformed at startup: run on defaults; the watcher picks up the
+        // corrected save like any other change
+        auto defaults = std::make_unique<Snapshot>();
+        defaults->version = nextVersion++;
+        publish (std::move (defaults));
+    }
+
+    startThread();
+}
+
+void ConfigStore::close()
+{
+    stopThread (-1);
+}
+
+//==============================================================================
+void ConfigStore::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (pollIntervalMs);
+
+        if (threadShouldExit())
+            return;
+
+        const auto modificationTime = file.getLastModificationTime();
+        if (modificationTime == lastModificationTime)
+            continue;
+
+        lastModificationTime = modificationTime;
+
+        // A malformed save keeps the previous snapshot active; the next
+        // save is picked up by the same modification-time check
+        if (auto next = parseProfile())
+            publish (std::move (next));
+    }
+}
+
+void ConfigStore::publish (std::unique_ptr<Snapshot> next)
+{
+    active.store (next.get(), std::memory_order_release);
+    activeVersion.store (next->version, std::memory_order_relaxed);
+
+    // The snapshot retired last reload dies here - one full reload interval
+    // after anything could have been reading it
+    retired = std::move (current);
+    current = std::move (next);
+}
+
+//==============================================================================
+std::unique_ptr<ConfigStore::Snapshot> ConfigStore::parseProfile()
+{
+    auto snapshot = std::make_unique<Snapshot>();
+    snapshot->version = nextVersion++;
+
+    if (! file.existsAsFile())
+        return snapshot;
+
+    const auto root = juce::JSON::parse (file.loadFileAsString());
+
+    if (! root.isObject())
+    {
+        DBG ("ConfigStore: could not parse " << file.getFullPathName());
+        --nextVersion;
+        return nullptr;
+    }
+
+    const auto input = root.getProperty ("input", {});
+
+    if (input.isObject())
+    {
+        // Only keys actually present make it into the snapshot; the apply
+        // step leaves everything else as the UI last set it
+        if (input.hasProperty ("gateThreshold"))
+        {
+            snapshot->hasGateThreshold = true;
+            snapshot->gateThreshold = (float) (double) input.getProperty ("gateThreshold", 0.0);
+        }
+
+        if (const auto* gains = input.getProperty ("channelGains", {}).getArray())
+        {
+            snapshot->numChannelGains = juce::jmin (gains->size(),
+                                                    (int) InputConditioner::maxChannels);
+
+            for (int i = 0; i < snapshot->numChannelGains; ++i)
+                snapshot->channelGains[i] = (float) (double) gains->getUnchecked (i);
+        }
+    }
+
+    if (const auto* routes = root.getProperty ("routing", {}).getArray())
+    {
+        // An explicit (even empty) routing array owns the matrix; an absent
+        // key leaves whatever the UI and OSC handlers have set
+        snapshot->hasRouting = true;
+
+        for (const auto& entry : *routes)
+        {
+            if (snapshot->numRoutes >= Snapshot::maxRoutes)
+                break;
+
+            // 1-based in the profile, matching the channel numbers in the UI
+            const int in = (int) entry.getProperty ("input", 0) - 1;
+            const int out = (int) entry.getProperty ("output", 0) - 1;
+
+            if (in < 0 || in >= RoutingMatrix::maxInputs
+                 || out < 0 || out >= RoutingMatrix::maxOutputs)
+                continue;
+
+            auto& route = snapshot->routes[snapshot->numRoutes++];
+            route.input = in;
+            route.output = out;
+            route.gain = (float) (double) entry.getProperty ("gain", 0.0);
+        }
+    }
+
+    return snapshot;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+#include "InputConditioner.h"
+
+//==============================================================================
+/**
+    Hot-reloadable performance profile shared with the audio thread.
+
+    The Python side reads config/config.yaml, but everything native was
+    hardcoded - retuning a gate threshold or a monitor route meant a restart
+    mid-set. The store parses a JSON profile at startup, then a background
+    thread polls its modification time and re-parses on every save. Each
+    parse builds a complete, immutable Snapshot and publishes it with a
+    single release pointer exchange; AudioEngine::process() does one acquire
+    load per block and re-applies settings only when the pointer moved, so a
+    block where nothing changed costs one load and one compare.
+
+    The previously active snapshot is retired only at the next successful
+    reload - saves arrive at human cadence, so by then no block can still be
+    reading it.
+
+    Keys absent from the profile leave the live values alone: a missing or
+    empty profile changes nothing, and a profile that only sets the gate
+    does not stomp input gains restored from saved settings or moved from
+    the UI.
+
+    Profile layout (JSON; channels and routes are 1-based, matching the UI):
+        {
+          "input":   { "gateThreshold": 0.02, "channelGains": [1.0, 1.5] },
+          "routing": [ { "input": 1, "output": 2, "gain": 0.8 } ]
+        }
+*/
+class ConfigStore : private juce::Thread
+{
+public:
+    struct Route
+    {
+        int input = 0;              // 0-based by the time they are in here
+        int output = 0;
+        float gain = 0.0f;
+    };
+
+    struct Snapshot
+    {
+        Snapshot()
+        {
+            for (auto& gain : channelGains)
+                gain = 1.0f;
+        }
+
+        juce::uint32 version = 0;
+
+        // Each section applies only when its key was present in the profile
+        bool hasGateThreshold = false;
+        float gateThreshold = 0.0f;
+
+        int numChannelGains = 0;
+        float channelGains[InputConditioner::maxChannels];
+
+        static constexpr int maxRoutes = 128;
+        bool hasRouting = false;
+        Route routes[maxRoutes];
+        int numRoutes = 0;
+    };
+
+    ConfigStore();
+    ~ConfigStore() override;
+
+    /** Message thread: parses the profile now and starts watching it. A
+        missing file yields defaults and is still watched, so creating it
+        later hot-loads without a restart.
+    */
+    void open (const juce::File& profileFile);
+    void close();
+
+    /** Audio thread: the active snapshot. One acquire load, never null
+        after open().
+    */
+    const Snapshot* getSnapshot() const { return active.load (std::memory_order_acquire); }
+
+    /** Message thread: bumps on every successful reload, for logging. */
+    juce::uint32 getVersion() const { return activeVersion.load (std::memory_order_relaxed); }
+
+private:
+    void run() override;
+    std::unique_ptr<Snapshot> parseProfile();
+    void publish (std::unique_ptr<Snapshot> next);
+
+    static constexpr int pollIntervalMs = 500;
+
+    juce::File file;
+    juce::Time lastModificationTime;
+    juce::uint32 nextVersion = 1;
+
+    std::atomic<const Snapshot*> active { nullptr };
+    std::atomic<juce::uint32> activeVersion { 0 };
+    std::unique_ptr<Snapshot> current, retired;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConfigStore)
+};
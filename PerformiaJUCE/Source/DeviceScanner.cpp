@@ -0,0 +1,69 @@
+#include "DeviceScanner.h"
+
+DeviceScanner::DeviceScanner (juce::AudioDeviceManager& managerToScan)
+    : juce::Thread ("Device Scanner"),
+      deviceManager (managerToScan)
+{
+    startThread();
+}
+
+DeviceScanner::~DeviceScanner()
+{
+    stopThread (5000);
+}
+
+DeviceScanner::Snapshot DeviceScanner::getCachedSnapshot() const
+{
+    const juce::ScopedLock lock (cacheLock);
+    return cache;
+}
+
+void DeviceScanner::refreshAsync (std::function<void()> onFinished)
+{
+    {
+        const juce::ScopedLock lock (cacheLock);
+        finishedCallback = std::move (onFinished);
+    }
+
+    refreshPending.store (true);
+    notify();
+}
+
+void DeviceScanner::run()
+{
+    while (! threadShouldExit())
+    {
+        if (! refreshPending.exchange (false))
+        {
+            wait (-1);
+            continue;
+        }
+
+        // The slow part: enumerate every device type off the message thread
+        Snapshot fresh;
+
+        juce::OwnedArray<juce::AudioIODeviceType> types;
+        deviceManager.createAudioDeviceTypes (types);
+
+        for (auto* type : types)
+        {
+            if (threadShouldExit())
+                return;
+
+            type->scanForDevices();
+            fresh.inputDevices.addArray (type->getDeviceNames (true));
+            fresh.outputDevices.addArray (type->getDeviceNames (false));
+        }
+
+        std::function<void()> callback;
+
+        {
+            const juce::ScopedLock lock (cacheLock);
+            cache = std::move (fresh);
+            callback = std::move (finishedCallback);
+        }
+
+        if (callback != nullptr)
+            juce::MessageManager::callAsync (std::move (callback));
+    }
+}
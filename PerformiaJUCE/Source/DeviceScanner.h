@@ -0,0 +1,46 @@
+#pragma once
+
+#include <juce_audio_devices/juce_audio_devices.h>
+
+//==============================================================================
+/**
+    Background audio-device enumeration with a cached snapshot.
+
+    scanForDevices() can block for seconds when Bluetooth audio is present,
+    and updateDeviceList() used to run it synchronously on the message thread.
+    The scanner keeps the last known device lists in a snapshot the UI can
+    read instantly; refreshAsync() queues a rescan on this thread and invokes
+    a completion callback on the message thread once the cache is updated.
+*/
+class DeviceScanner : private juce::Thread
+{
+public:
+    struct Snapshot
+    {
+        juce::StringArray inputDevices;
+        juce::StringArray outputDevices;
+    };
+
+    explicit DeviceScanner (juce::AudioDeviceManager& managerToScan);
+    ~DeviceScanner() override;
+
+    /** Message thread: returns the cached lists without touching any device. */
+    Snapshot getCachedSnapshot() const;
+
+    /** Queues a background rescan. onFinished runs on the message thread
+        after the cache has been refreshed.
+    */
+    void refreshAsync (std::function<void()> onFinished);
+
+private:
+    void run() override;
+
+    juce::AudioDeviceManager& deviceManager;
+
+    mutable juce::CriticalSection cacheLock;
+    Snapshot cache;
+    std::function<void()> finishedCallback;
+    std::atomic<bool> refreshPending { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeviceScanner)
+};
@@ -0,0 +1,182 @@
+#include <juce_core/juce_core.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "FlightRecorder.h"
+
+//==============================================================================
+/*
+    performia_flightdump: renders a flight-recorder ring file to text.
+
+    The live writer appends fixed 32-byte records into a preallocated
+    memory-mapped ring (see FlightRecorder.h for the layout). This tool
+    replays that ring in sequence order, oldest surviving record first,
+    skipping never-written and torn slots, so a post-mortem after a crash
+    is one command:
+
+        performia_flightdump ~/Documents/Performia\ Logs/flight.pflt
+*/
+
+namespace
+{
+
+struct RawRecord
+{
+    juce::uint64 sequence;
+    juce::uint64 timeMicros;
+    juce::uint32 type;
+    juce::int32 intValue;
+    float value1;
+    float value2;
+};
+
+void printRecord (const RawRecord& record, juce::uint64 firstTimeMicros)
+{
+    const double seconds = (double) (record.timeMicros - firstTimeMicros) * 1.0e-6;
+
+    std::printf ("%12.6f  %-18s", seconds, FlightRecorder::getEventTypeName (record.type));
+
+    switch ((FlightRecorder::EventType) record.type)
+    {
+        case FlightRecorder::EventType::deviceChanged:
+            std::printf ("rate=%.0fHz buffer=%.0f", record.value1, record.value2);
+            break;
+
+        case FlightRecorder::EventType::powerToggled:
+        case FlightRecorder::EventType::testToneToggled:
+        case FlightRecorder::EventType::monitorToggled:
+        case FlightRecorder::EventType::recordingToggled:
+            std::printf ("%s", record.intValue != 0 ? "on" : "off");
+            break;
+
+        case FlightRecorder::EventType::latencyMeasured:
+            if (record.intValue >= 0)
+                std::printf ("%d samples (%.2f ms)", record.intValue, record.value1);
+            else
+                std::printf ("failed");
+            break;
+
+        case FlightRecorder::EventType::inputGainChanged:
+            std::printf ("channel %d gain=%.3f", record.intValue + 1, record.value1);
+            break;
+
+        case FlightRecorder::EventType::outputGainChanged:
+            std::printf ("gain=%.3f", record.value1);
+            break;
+
+        case FlightRecorder::EventType::testFrequencyChanged:
+            std::printf ("%.0f Hz", record.value1);
+            break;
+
+        case FlightRecorder::EventType::inputChannelChanged:
+            std::printf ("channel %d", record.intValue + 1);
+            break;
+
+        case FlightRecorder::EventType::secondaryDeviceChanged:
+            std::printf ("%s", record.intValue != 0 ? "opened" : "closed");
+            break;
+
+        case FlightRecorder::EventType::oscEvent:
+            std::printf ("type=%d value1=%.3f value2=%.3f",
+                         record.intValue, record.value1, record.value2);
+            break;
+
+        case FlightRecorder::EventType::pedalEvent:
+            std::printf ("cc%d=%d", record.intValue, (int) record.value1);
+            break;
+
+        case FlightRecorder::EventType::xrun:
+            std::printf ("total=%d", record.intValue);
+            break;
+
+        case FlightRecorder::EventType::configReloaded:
+            std::printf ("version=%d", record.intValue);
+            break;
+
+        case FlightRecorder::EventType::sessionStart:
+            break;
+    }
+
+    std::printf ("\n");
+}
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::fprintf (stderr, "usage: performia_flightdump <flight-recorder-file>\n");
+        return 1;
+    }
+
+    const juce::File file (juce::File::getCurrentWorkingDirectory()
+                               .getChildFile (juce::String (argv[1])));
+
+    juce::FileInputStream input (file);
+    if (input.failedToOpen())
+    {
+        std::fprintf (stderr, "could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    if ((juce::uint32) input.readInt() != FlightRecorder::fileMagic
+         || (juce::uint32) input.readInt() != FlightRecorder::fileVersion)
+    {
+        std::fprintf (stderr, "%s is not a flight-recorder file\n", argv[1]);
+        return 1;
+    }
+
+    const auto capacity = (juce::uint32) input.readInt();
+    const auto recordBytes = (juce::uint32) input.readInt();
+
+    if (recordBytes != sizeof (RawRecord))
+    {
+        std::fprintf (stderr, "unsupported record size %u\n", recordBytes);
+        return 1;
+    }
+
+    std::vector<RawRecord> records (capacity);
+    input.setPosition (FlightRecorder::headerBytes);
+    input.read (records.data(), (int) (capacity * recordBytes));
+
+    // Replay in sequence order. The oldest surviving record is the smallest
+    // sequence in the ring; never-written slots are 0 and torn slots carry a
+    // sequence that doesn't map back to their index.
+    juce::uint64 oldest = 0, newest = 0;
+
+    for (juce::uint32 i = 0; i < capacity; ++i)
+    {
+        const auto sequence = records[i].sequence;
+        if (sequence == 0 || (sequence - 1) % capacity != i)
+            continue;
+
+        if (oldest == 0 || sequence < oldest)
+            oldest = sequence;
+        newest = juce::jmax (newest, sequence);
+    }
+
+    if (oldest == 0)
+    {
+        std::printf ("empty log\n");
+        return 0;
+    }
+
+    const auto firstTimeMicros = records[(oldest - 1) % capacity].timeMicros;
+    juce::uint64 printed = 0;
+
+    for (auto sequence = oldest; sequence <= newest; ++sequence)
+    {
+        const auto& record = records[(sequence - 1) % capacity];
+        if (record.sequence != sequence)
+            continue;      // Torn or already overwritten
+
+        printRecord (record, firstTimeMicros);
+        ++printed;
+    }
+
+    std::printf ("%llu records\n", (unsigned long long) printed);
+    return 0;
+}
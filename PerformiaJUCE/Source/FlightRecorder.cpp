@@ -0,0 +1,128 @@
+#include "FlightRecorder.h"
+
+//==============================================================================
+FlightRecorder::FlightRecorder() = default;
+
+FlightRecorder::~FlightRecorder()
+{
+    close();
+}
+
+const char* FlightRecorder::getEventTypeName (juce::uint32 type)
+{
+    switch ((EventType) type)
+    {
+        case EventType::sessionStart:            return "session-start";
+        case EventType::deviceChanged:           return "device-changed";
+        case EventType::powerToggled:            return "power";
+        case EventType::testToneToggled:         return "test-tone";
+        case EventType::monitorToggled:          return "monitor";
+        case EventType::recordingToggled:        return "recording";
+        case EventType::latencyMeasured:         return "latency-measured";
+        case EventType::inputGainChanged:        return "input-gain";
+        case EventType::outputGainChanged:       return "output-gain";
+        case EventType::testFrequencyChanged:    return "test-frequency";
+        case EventType::inputChannelChanged:     return "input-channel";
+        case EventType::secondaryDeviceChanged:  return "secondary-device";
+        case EventType::oscEvent:                return "osc-event";
+        case EventType::pedalEvent:              return "pedal-event";
+        case EventType::xrun:                    return "xrun";
+        case EventType::configReloaded:          return "config-reloaded";
+    }
+
+    return "unknown";
+}
+
+bool FlightRecorder::open (const juce::File& file)
+{
+    close();
+
+    const juce::int64 fileBytes = headerBytes
+                                   + (juce::int64) recordCapacity * (juce::int64) sizeof (Record);
+
+    // Recreate the file only when it is missing or from a different layout;
+    // a valid existing ring is continued so the previous session's tail
+    // stays readable until new records overwrite it
+    bool needsInit = file.getSize() != fileBytes;
+
+    if (! needsInit)
+    {
+        juce::FileInputStream probe (file);
+        needsInit = probe.failedToOpen()
+                     || (juce::uint32) probe.readInt() != fileMagic
+                     || (juce::uint32) probe.readInt() != fileVersion
+                     || (juce::uint32) probe.readInt() != (juce::uint32) recordCapacity
+                     || (juce::uint32) probe.readInt() != (juce::uint32) sizeof (Record);
+    }
+
+    if (needsInit)
+    {
+        file.deleteFile();
+        file.getParentDirectory().createDirectory();
+
+        juce::FileOutputStream init (file);
+        if (init.failedToOpen())
+            return false;
+
+        init.writeInt ((int) fileMagic);
+        init.writeInt ((int) fileVersion);
+        init.writeInt (recordCapacity);
+        init.writeInt ((int) sizeof (Record));
+
+        // Zero-fill the rest so every page is really allocated on disk and
+        // a writer never grows the file
+        juce::HeapBlock<char> zeros ((size_t) 65536, true);
+        for (juce::int64 written = 16; written < fileBytes;)
+        {
+            const auto chunk = juce::jmin (fileBytes - written, (juce::int64) 65536);
+            init.write (zeros, (size_t) chunk);
+            written += chunk;
+        }
+    }
+
+    mapping = std::make_unique<juce::MemoryMappedFile> (
+        file, juce::Range<juce::int64> (0, fileBytes),
+        juce::MemoryMappedFile::readWrite);
+
+    if (mapping->getData() == nullptr)
+    {
+        mapping = nullptr;
+        return false;
+    }
+
+    auto* mapped = (Header*) mapping->getData();
+    records = (Record*) ((char*) mapping->getData() + headerBytes);
+
+    // Publish last: log() treats a null header as "not open yet"
+    header.store (mapped, std::memory_order_release);
+    return true;
+}
+
+void FlightRecorder::close()
+{
+    header.store (nullptr, std::memory_order_release);
+    records = nullptr;
+    mapping = nullptr;
+}
+
+void FlightRecorder::log (EventType type, int intValue, float value1, float value2)
+{
+    auto* mapped = header.load (std::memory_order_acquire);
+    if (mapped == nullptr)
+        return;
+
+    // One fetch_add claims a slot; concurrent writers (message, audio and
+    // MIDI threads) can never collide on a record. The sequence is stored
+    // last so a crash mid-write leaves a record the dump tool can reject.
+    const auto sequence = mapped->nextSequence.fetch_add (1, std::memory_order_relaxed);
+    auto& record = records[sequence % (juce::uint64) recordCapacity];
+
+    record.timeMicros = (juce::uint64) (juce::Time::getHighResolutionTicks() * 1.0e6
+                                         / (double) juce::Time::getHighResolutionTicksPerSecond());
+    record.type = (juce::uint32) type;
+    record.intValue = intValue;
+    record.value1 = value1;
+    record.value2 = value2;
+
+    record.sequence.store (sequence + 1, std::memory_order_release);
+}
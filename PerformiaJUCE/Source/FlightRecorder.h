@@ -0,0 +1,107 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+//==============================================================================
+/**
+    Crash-safe binary session log of control events.
+
+    DBG() is compiled out of release builds, so a glitch mid-performance
+    used to leave nothing to diagnose with. The flight recorder appends one
+    fixed 32-byte record per control change (device switches, gain moves,
+    monitor toggles, OSC and pedal events) and per xrun to a preallocated
+    memory-mapped ring file. Writers claim a slot with one fetch_add on a
+    counter that itself lives in the mapped header, fill the record and
+    release-store its sequence last - no locks, no syscalls, well under a
+    microsecond, and everything already written survives a crash because the
+    kernel owns the dirty pages. The same file is reused across sessions, so
+    the tail of a crashed run is still there on restart.
+
+    performia_flightdump renders a log back to text offline.
+
+    File layout (little-endian):
+        header, 64 bytes:
+            magic 'PFLT' | version u32 | recordCapacity u32 | recordBytes u32
+            | reserved u32 x4 | nextSequence u64 (live counter) | reserved
+        records, recordCapacity x 32 bytes:
+            sequence u64 (0 = never written) | timeMicros u64 | type u32
+            | intValue i32 | value1 f32 | value2 f32
+*/
+class FlightRecorder
+{
+public:
+    static constexpr juce::uint32 fileMagic = 0x544c4650;   // 'PFLT'
+    static constexpr juce::uint32 fileVersion = 1;
+    static constexpr int headerBytes = 64;
+    static constexpr int recordCapacity = 1 << 16;          // 2MB of records
+
+    enum class EventType : juce::uint32
+    {
+        sessionStart = 1,
+        deviceChanged,          // value1 = sample rate, value2 = buffer size
+        powerToggled,           // intValue = 0/1
+        testToneToggled,        // intValue = 0/1
+        monitorToggled,         // intValue = 0/1
+        recordingToggled,       // intValue = 0/1
+        latencyMeasured,        // intValue = round-trip samples, -1 = failed
+        inputGainChanged,       // intValue = channel, value1 = linear gain
+        outputGainChanged,      // value1 = linear gain
+        testFrequencyChanged,   // value1 = Hz
+        inputChannelChanged,    // intValue = channel index
+        secondaryDeviceChanged, // intValue = 0 closed / 1 opened
+        oscEvent,               // intValue = OscEvent::Type, value1/2 = payload
+        pedalEvent,             // intValue = controller, value1 = value
+        xrun,                   // intValue = total xruns so far
+        configReloaded          // intValue = snapshot version
+    };
+
+    struct Record
+    {
+        std::atomic<juce::uint64> sequence;
+        juce::uint64 timeMicros;
+        juce::uint32 type;
+        juce::int32 intValue;
+        float value1;
+        float value2;
+    };
+
+    FlightRecorder();
+    ~FlightRecorder();
+
+    /** Message thread: maps (or creates) the ring file and starts accepting
+        events. An existing file from a previous session is continued, not
+        truncated, so its tail stays readable until it is overwritten.
+    */
+    bool open (const juce::File& file);
+    void close();
+
+    /** Any thread: appends one record. Wait-free and allocation-free; a
+        no-op until open() has succeeded.
+    */
+    void log (EventType type, int intValue = 0,
+              float value1 = 0.0f, float value2 = 0.0f);
+
+    static const char* getEventTypeName (juce::uint32 type);
+
+private:
+    struct Header
+    {
+        juce::uint32 magic;
+        juce::uint32 version;
+        juce::uint32 recordCapacity;
+        juce::uint32 recordBytes;
+        juce::uint32 reserved1[4];
+        std::atomic<juce::uint64> nextSequence;
+        juce::uint32 reserved2[6];
+    };
+
+    static_assert (sizeof (Header) == headerBytes, "header layout is part of the file format");
+    static_assert (sizeof (Record) == 32, "record layout is part of the file format");
+
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    std::atomic<Header*> header { nullptr };
+    Record* records = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlightRecorder)
+};
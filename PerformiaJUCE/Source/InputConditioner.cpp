@@ -0,0 +1,108 @@
+#include "InputConditioner.h"
+
+//==============================================================================
+InputConditioner::InputConditioner()
+{
+    for (auto& gain : gainTargets)
+        gain.store (1.0f, std::memory_order_relaxed);
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        currentGains[channel] = 1.0f;
+        lowPassState[channel] = 0.0f;
+        envelopes[channel] = 0.0f;
+        gateGains[channel] = 1.0f;
+    }
+}
+
+void InputConditioner::prepare (int numChannelsToCondition, double sampleRate)
+{
+    numChannels = juce::jmin (numChannelsToCondition, maxChannels);
+
+    // ~20Hz one-pole: low enough to leave bass fundamentals alone, high
+    // enough to kill the DC a piezo pickup rides in on
+    highPassCoefficient = 1.0f - std::exp ((float) (-2.0 * juce::MathConstants<double>::pi
+                                                     * 20.0 / sampleRate));
+
+    // ~50ms envelope release and ~5ms gate fade, per sample
+    envelopeDecay = std::exp ((float) (-1.0 / (0.05 * sampleRate)));
+    gateSlew = 1.0f - std::exp ((float) (-1.0 / (0.005 * sampleRate)));
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        currentGains[channel] = gainTargets[channel].load (std::memory_order_relaxed);
+        lowPassState[channel] = 0.0f;
+        envelopes[channel] = 0.0f;
+        gateGains[channel] = 1.0f;
+    }
+}
+
+void InputConditioner::setChannelGain (int channel, float gain)
+{
+    if (juce::isPositiveAndBelow (channel, maxChannels))
+        gainTargets[channel].store (juce::jlimit (0.0f, 4.0f, gain),
+                                    std::memory_order_relaxed);
+}
+
+float InputConditioner::getChannelGain (int channel) const
+{
+    if (juce::isPositiveAndBelow (channel, maxChannels))
+        return gainTargets[channel].load (std::memory_order_relaxed);
+
+    return 1.0f;
+}
+
+void InputConditioner::setGateThreshold (float threshold)
+{
+    gateThreshold.store (juce::jmax (0.0f, threshold), std::memory_order_relaxed);
+}
+
+//==============================================================================
+void InputConditioner::processBlock (juce::AudioBuffer<float>& buffer,
+                                     int startSample, int numSamples)
+{
+    const int channels = juce::jmin (numChannels, buffer.getNumChannels());
+    const float threshold = gateThreshold.load (std::memory_order_relaxed);
+    const bool gateActive = threshold > 0.0f;
+    const float invNumSamples = 1.0f / (float) numSamples;
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        auto* data = buffer.getWritePointer (channel, startSample);
+
+        // Latch this block's gain target and ramp linearly across the block
+        const float gainStep = (gainTargets[channel].load (std::memory_order_relaxed)
+                                 - currentGains[channel]) * invNumSamples;
+
+        float gain = currentGains[channel];
+        float lowPass = lowPassState[channel];
+        float envelope = envelopes[channel];
+        float gateGain = gateGains[channel];
+
+        // Fused pass: high-pass, gain and gate in one read and one write
+        // per sample; all state stays in registers across the loop
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float input = data[i];
+
+            lowPass += highPassCoefficient * (input - lowPass);
+            gain += gainStep;
+
+            float sample = (input - lowPass) * gain;
+
+            if (gateActive)
+            {
+                envelope = juce::jmax (std::abs (sample), envelope * envelopeDecay);
+                gateGain += gateSlew * ((envelope >= threshold ? 1.0f : 0.0f) - gateGain);
+                sample *= gateGain;
+            }
+
+            data[i] = sample;
+        }
+
+        currentGains[channel] = gain;
+        lowPassState[channel] = lowPass;
+        envelopes[channel] = envelope;
+        gateGains[channel] = gateGain;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <atomic>
+
+//==============================================================================
+/**
+    Per-channel input conditioning: gain, DC removal and an optional gate.
+
+    The old input path had one scalar gain for every channel - which is why
+    the gain slider grew a 0-200 "weak signal" range: boosting a quiet piezo
+    meant boosting the noise on all 26 channels with it. This stage runs
+    first in the graph, so everything downstream (metering, analysis, the
+    recorder, the shm bus) sees conditioned signal.
+
+    Per channel it applies a ramped gain, a one-pole high-pass that strips
+    DC offset (piezo pickups are the repeat offender), and an optional
+    envelope-followed noise gate, all fused into one loop that reads and
+    writes each sample exactly once. All state lives in flat per-channel
+    arrays (structure-of-arrays), so conditioning 26 channels is a cache-
+    friendly linear sweep the compiler can keep in registers.
+
+    Control values arrive through per-channel atomics; the audio thread
+    latches them once per block, so there is nothing to lock.
+*/
+class InputConditioner
+{
+public:
+    static constexpr int maxChannels = 64;
+
+    InputConditioner();
+
+    void prepare (int numChannelsToCondition, double sampleRate);
+
+    /** Audio thread: conditions every input channel in place. */
+    void processBlock (juce::AudioBuffer<float>& buffer,
+                       int startSample, int numSamples);
+
+    //==============================================================================
+    // Message-thread / OSC control
+    void setChannelGain (int channel, float gain);
+    float getChannelGain (int channel) const;
+
+    /** Linear threshold the gate closes below; 0 disables the gate. */
+    void setGateThreshold (float threshold);
+    float getGateThreshold() const { return gateThreshold.load (std::memory_order_relaxed); }
+
+private:
+    int numChannels = 0;
+
+    // One-pole high-pass (~20Hz) and gate ballistics, set in prepare()
+    float highPassCoefficient = 0.0f;
+    float envelopeDecay = 0.0f;
+    float gateSlew = 0.0f;
+
+    // UI/OSC -> audio thread targets
+    std::atomic<float> gainTargets[maxChannels];
+    std::atomic<float> gateThreshold { 0.0f };
+
+    // Audio-thread state, structure-of-arrays so the fused loop sweeps
+    // flat memory instead of chasing per-channel objects
+    float currentGains[maxChannels];
+    float lowPassState[maxChannels];
+    float envelopes[maxChannels];
+    float gateGains[maxChannels];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InputConditioner)
+};
@@ -0,0 +1,144 @@
+#include "LatencyProbe.h"
+
+//==============================================================================
+LatencyProbe::LatencyProbe()
+    : juce::Thread ("Latency Probe")
+{
+    buildChirp();
+}
+
+LatencyProbe::~LatencyProbe()
+{
+    stopThread (2000);
+}
+
+void LatencyProbe::buildChirp()
+{
+    // Hann-windowed linear chirp, 500Hz to 4kHz: sharp autocorrelation peak,
+    // survives converters and cheap loopback cables better than a bare click
+    for (int i = 0; i < chirpLength; ++i)
+    {
+        const double t = (double) i / chirpLength;
+        const double phase = 2.0 * juce::MathConstants<double>::pi
+                               * (500.0 * t + 0.5 * 3500.0 * t * t)
+                               * chirpLength / sampleRate;
+        const double window = 0.5 - 0.5 * std::cos (2.0 * juce::MathConstants<double>::pi * t);
+
+        chirp[i] = (float) (0.5 * window * std::sin (phase));
+    }
+}
+
+void LatencyProbe::prepare (double sampleRateToUse)
+{
+    stopThread (2000);
+
+    sampleRate = sampleRateToUse;
+    captureCapacity = (int) sampleRate;          // One second is plenty
+    capture.allocate ((size_t) captureCapacity, true);
+    buildChirp();
+
+    state.store (State::idle, std::memory_order_relaxed);
+    armed.store (false, std::memory_order_relaxed);
+
+    // The analysis thread is resident from here on, parked on wait(), so
+    // completing a capture never creates a thread on the audio callback
+    startThread (Priority::normal);
+}
+
+void LatencyProbe::startMeasurement()
+{
+    const auto current = state.load (std::memory_order_relaxed);
+    if (current == State::capturing || current == State::analysing)
+        return;
+
+    emitPosition = 0;
+    capturePosition = 0;
+    roundTripSamples.store (-1, std::memory_order_relaxed);
+    state.store (State::capturing, std::memory_order_relaxed);
+    armed.store (true, std::memory_order_release);
+}
+
+//==============================================================================
+void LatencyProbe::renderOutput (float* dest, int numSamples)
+{
+    if (! armed.load (std::memory_order_acquire) || emitPosition >= chirpLength)
+        return;
+
+    const int toWrite = juce::jmin (numSamples, chirpLength - emitPosition);
+    juce::FloatVectorOperations::add (dest, chirp + emitPosition, toWrite);
+    emitPosition += toWrite;
+}
+
+void LatencyProbe::captureInput (const float* input, int numSamples)
+{
+    if (! armed.load (std::memory_order_acquire))
+        return;
+
+    const int toWrite = juce::jmin (numSamples, captureCapacity - capturePosition);
+    if (toWrite > 0)
+    {
+        juce::FloatVectorOperations::copy (capture + capturePosition, input, toWrite);
+        capturePosition += toWrite;
+    }
+
+    if (capturePosition >= captureCapacity)
+    {
+        // Capture complete - wake the parked analysis thread. The release
+        // store on state publishes the capture buffer writes above.
+        armed.store (false, std::memory_order_release);
+        state.store (State::analysing, std::memory_order_release);
+        notify();
+    }
+}
+
+//==============================================================================
+void LatencyProbe::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (-1);
+
+        if (! threadShouldExit()
+             && state.load (std::memory_order_acquire) == State::analysing)
+            analyse();
+    }
+}
+
+void LatencyProbe::analyse()
+{
+    // Brute-force cross-correlation against the reference chirp; ~25M
+    // multiply-adds, well under a second on the background thread
+    const int maxLag = captureCapacity - chirpLength;
+
+    int bestLag = -1;
+    float bestCorrelation = 0.0f;
+    float energy = 0.0f;
+
+    for (int lag = 0; lag <= maxLag && ! threadShouldExit(); ++lag)
+    {
+        float correlation = 0.0f;
+        for (int i = 0; i < chirpLength; ++i)
+            correlation += capture[lag + i] * chirp[i];
+
+        if (correlation > bestCorrelation)
+        {
+            bestCorrelation = correlation;
+            bestLag = lag;
+        }
+
+        energy += capture[lag] * capture[lag];
+    }
+
+    // Require the peak to clearly beat the capture's average level so a
+    // missing loopback cable reports failure instead of a random number
+    const float meanLevel = std::sqrt (energy / (float) juce::jmax (1, maxLag));
+
+    if (bestLag < 0 || bestCorrelation < 4.0f * meanLevel * (float) chirpLength * 0.05f)
+    {
+        state.store (State::failed, std::memory_order_relaxed);
+        return;
+    }
+
+    roundTripSamples.store (bestLag, std::memory_order_relaxed);
+    state.store (State::done, std::memory_order_relaxed);
+}
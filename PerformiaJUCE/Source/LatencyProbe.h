@@ -0,0 +1,69 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Loopback round-trip latency measurement.
+
+    Patch an output into the selected input (or put a mic on the monitor),
+    arm the probe, and it emits one short windowed chirp from the audio
+    callback while recording the input into a preallocated one-second
+    capture buffer. A resident analysis thread - started in prepare(),
+    parked on wait() between measurements - then cross-correlates the
+    capture against the reference chirp; the correlation peak's lag is the
+    true round-trip through driver, converter and cabling - the number the
+    buffer-size arithmetic in the device info panel can only estimate.
+    Audio-thread cost while armed is one chirp write, one block copy and a
+    single notify() when the capture fills.
+*/
+class LatencyProbe : private juce::Thread
+{
+public:
+    enum class State { idle, capturing, analysing, done, failed };
+
+    LatencyProbe();
+    ~LatencyProbe() override;
+
+    void prepare (double sampleRateToUse);
+
+    /** Message thread: arms the probe. The next audio block emits the chirp. */
+    void startMeasurement();
+
+    //==============================================================================
+    // Audio-thread hooks
+    /** Adds the chirp to one output channel while a measurement is armed. */
+    void renderOutput (float* dest, int numSamples);
+
+    /** Appends the raw input to the capture buffer while measuring. */
+    void captureInput (const float* input, int numSamples);
+
+    //==============================================================================
+    // Message-thread readers
+    State getState() const           { return state.load (std::memory_order_relaxed); }
+    int getRoundTripSamples() const  { return roundTripSamples.load (std::memory_order_relaxed); }
+    double getRoundTripMs() const    { return getRoundTripSamples() * 1000.0 / sampleRate; }
+
+private:
+    void run() override;
+    void analyse();
+    void buildChirp();
+
+    static constexpr int chirpLength = 512;
+
+    float chirp[chirpLength];
+    juce::HeapBlock<float> capture;
+    int captureCapacity = 0;
+
+    std::atomic<State> state { State::idle };
+    std::atomic<int> roundTripSamples { -1 };
+
+    // Audio-thread state
+    std::atomic<bool> armed { false };
+    int emitPosition = 0;
+    int capturePosition = 0;
+
+    double sampleRate = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LatencyProbe)
+};
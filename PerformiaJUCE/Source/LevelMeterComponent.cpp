@@ -0,0 +1,75 @@
+#include "LevelMeterComponent.h"
+
+//==============================================================================
+LevelMeterComponent::LevelMeterComponent (Style styleToUse)
+    : style (styleToUse)
+{
+    // The meter body never changes shape, so everything outside the dirty
+    // span comes back from the component's cached image for free
+    setOpaque (false);
+    setBufferedToImage (true);
+    setInterceptsMouseClicks (false, false);
+}
+
+int LevelMeterComponent::levelToY (float value) const
+{
+    return getHeight() - juce::roundToInt (getHeight() * juce::jlimit (0.0f, 1.0f, value));
+}
+
+void LevelMeterComponent::setLevels (float newLevel, float newPeakHold)
+{
+    const int barY = levelToY (newLevel);
+    const int peakY = newPeakHold > 0.01f ? levelToY (newPeakHold) : -1;
+
+    level = newLevel;
+    peakHold = newPeakHold;
+
+    if (barY == lastBarY && peakY == lastPeakY)
+        return;
+
+    // Repaint only the rows between the old and new bar tops, plus the old
+    // and new peak lines (2px each, widened by a pixel for antialiasing)
+    auto dirty = juce::Rectangle<int> (0, juce::jmin (barY, lastBarY < 0 ? barY : lastBarY),
+                                       getWidth(), std::abs (barY - (lastBarY < 0 ? barY : lastBarY)) + 1);
+
+    for (int y : { peakY, lastPeakY })
+        if (y >= 0)
+            dirty = dirty.getUnion ({ 0, y - 2, getWidth(), 5 });
+
+    lastBarY = barY;
+    lastPeakY = peakY;
+
+    repaint (dirty);
+}
+
+void LevelMeterComponent::paint (juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    // Background
+    g.setColour (juce::Colour (0xff1a1a1a));
+    g.fillRoundedRectangle (bounds, 5.0f);
+
+    // Level bar
+    auto meterHeight = bounds.getHeight() * juce::jlimit (0.0f, 1.0f, level);
+    auto meterBounds = bounds.removeFromBottom (meterHeight);
+
+    // Color based on level
+    if (level > 0.9f)
+        g.setColour (juce::Colour (0xffff0000));
+    else if (level > 0.7f)
+        g.setColour (juce::Colour (0xffffd600));
+    else
+        g.setColour (style == Style::input ? juce::Colour (0xff00d9ff)
+                                           : juce::Colour (0xff00ff41));
+
+    g.fillRoundedRectangle (meterBounds, 5.0f);
+
+    // Peak hold line
+    if (peakHold > 0.01f)
+    {
+        float peakY = bounds.getBottom() - (bounds.getHeight() * peakHold);
+        g.setColour (juce::Colours::white);
+        g.drawLine (bounds.getX(), peakY, bounds.getRight(), peakY, 2.0f);
+    }
+}
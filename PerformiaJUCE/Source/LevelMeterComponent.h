@@ -0,0 +1,38 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+//==============================================================================
+/**
+    A single vertical level meter that repaints only its own dirty region.
+
+    The timer thread feeds it smoothed level and peak-hold values; the
+    component quantizes them to pixel rows and issues a repaint() covering
+    just the rows that changed, so an idle meter costs nothing and a moving
+    one redraws a few dozen pixels instead of the whole window.
+*/
+class LevelMeterComponent : public juce::Component
+{
+public:
+    enum class Style { input, output };
+
+    explicit LevelMeterComponent (Style styleToUse);
+
+    /** Message thread: updates the displayed values, repainting only the
+        vertical span that actually moved.
+    */
+    void setLevels (float newLevel, float newPeakHold);
+
+    void paint (juce::Graphics& g) override;
+
+private:
+    int levelToY (float value) const;
+
+    Style style;
+    float level = 0.0f;
+    float peakHold = 0.0f;
+    int lastBarY = -1;
+    int lastPeakY = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeterComponent)
+};
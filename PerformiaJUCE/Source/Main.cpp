@@ -1,4 +1,4 @@
-#include <JuceHeader.h>
+#include <juce_gui_extra/juce_gui_extra.h>
 #include "MainComponent.h"
 
 //==============================================================================
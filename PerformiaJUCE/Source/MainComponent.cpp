@@ -12,6 +12,8 @@ MainComponent::MainComponent()
     powerButton.addListener (this);
     testToneButton.addListener (this);
     inputMonitorButton.addListener (this);
+    recordButton.addListener (this);
+    measureLatencyButton.addListener (this);
     showAudioSettingsButton.addListener (this);
     refreshDevicesButton.addListener (this);
     
@@ -19,12 +21,16 @@ MainComponent::MainComponent()
     powerButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
     testToneButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
     inputMonitorButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
+    recordButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
+    measureLatencyButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
     showAudioSettingsButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff2a2a2a));
     refreshDevicesButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff2a2a2a));
     
     addAndMakeVisible (powerButton);
     addAndMakeVisible (testToneButton);
     addAndMakeVisible (inputMonitorButton);
+    addAndMakeVisible (recordButton);
+    addAndMakeVisible (measureLatencyButton);
     addAndMakeVisible (showAudioSettingsButton);
     addAndMakeVisible (refreshDevicesButton);
     
@@ -44,14 +50,29 @@ MainComponent::MainComponent()
     inputChannelLabel.setColour (juce::Label::textColourId, juce::Colour (0xff606060));
     addAndMakeVisible (inputChannelLabel);
     addAndMakeVisible (inputChannelSelector);
-    
-    // Input gain slider
+
+    // Secondary capture device slot
+    secondaryDeviceLabel.setText ("2ND INPUT DEVICE:", juce::dontSendNotification);
+    secondaryDeviceLabel.setColour (juce::Label::textColourId, juce::Colour (0xff606060));
+    addAndMakeVisible (secondaryDeviceLabel);
+    addAndMakeVisible (secondaryDeviceSelector);
+    
+    // Input gain slider: trims the selected channel only, in percent. The
+    // conditioner applies it per channel, so boosting a weak piezo no
+    // longer boosts the noise floor of every other input with it.
     inputGainSlider.setSliderStyle (juce::Slider::LinearHorizontal);
-    inputGainSlider.setRange (0.0, 200.0, 1.0);  // Increased range for weak signals
+    inputGainSlider.setRange (0.0, 200.0, 1.0);
     inputGainSlider.setValue (100.0);
     inputGainSlider.setTextBoxStyle (juce::Slider::TextBoxRight, false, 50, 20);
+    inputGainSlider.onValueChange = [this]
+    {
+        const int channel = juce::jmax (0, inputChannelSelector.getSelectedId() - 1);
+        const auto gain = (float) (inputGainSlider.getValue() / 100.0);
+        audioEngine.getInputConditioner().setChannelGain (channel, gain);
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::inputGainChanged, channel, gain);
+    };
     addAndMakeVisible (inputGainSlider);
-    
+
     inputGainLabel.setText ("INPUT GAIN", juce::dontSendNotification);
     inputGainLabel.setColour (juce::Label::textColourId, juce::Colour (0xff606060));
     addAndMakeVisible (inputGainLabel);
@@ -61,6 +82,12 @@ MainComponent::MainComponent()
     outputVolumeSlider.setRange (0.0, 100.0, 1.0);
     outputVolumeSlider.setValue (75.0);
     outputVolumeSlider.setTextBoxStyle (juce::Slider::TextBoxRight, false, 50, 20);
+    outputVolumeSlider.onValueChange = [this]
+    {
+        const auto gain = (float) (outputVolumeSlider.getValue() / 100.0);
+        parameters.setOutputGain (gain);
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::outputGainChanged, 0, gain);
+    };
     addAndMakeVisible (outputVolumeSlider);
     
     outputVolumeLabel.setText ("OUTPUT VOLUME", juce::dontSendNotification);
@@ -72,7 +99,13 @@ MainComponent::MainComponent()
     testFreqSlider.setRange (100.0, 1000.0, 1.0);
     testFreqSlider.setValue (440.0);
     testFreqSlider.setTextBoxStyle (juce::Slider::TextBoxRight, false, 60, 20);
-    testFreqSlider.onValueChange = [this] { testToneFrequency = testFreqSlider.getValue(); };
+    testFreqSlider.onValueChange = [this]
+    {
+        testToneFrequency = testFreqSlider.getValue();
+        parameters.setTestToneFrequency (testToneFrequency);
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::testFrequencyChanged,
+                                             0, (float) testToneFrequency);
+    };
     addAndMakeVisible (testFreqSlider);
     
     testFreqLabel.setText ("TEST FREQ (Hz)", juce::dontSendNotification);
@@ -90,11 +123,73 @@ MainComponent::MainComponent()
     deviceInfoLabel.setFont (juce::FontOptions("Monaco", 11.0f, juce::Font::plain));
     deviceInfoLabel.setJustificationType (juce::Justification::topLeft);
     addAndMakeVisible (deviceInfoLabel);
-    
-    // IMPORTANT: Request maximum channels initially
-    // This ensures we can access all available inputs
-    auto result = setAudioChannels (256, 2);  // Request many input channels
-    
+
+    // Volatile figures (load, xruns) live in their own small label so the
+    // timer never rebuilds the full device description
+    perfInfoLabel.setText ("", juce::dontSendNotification);
+    perfInfoLabel.setColour (juce::Label::textColourId, juce::Colour (0xff808080));
+    perfInfoLabel.setFont (juce::FontOptions("Monaco", 11.0f, juce::Font::plain));
+    perfInfoLabel.setJustificationType (juce::Justification::topLeft);
+    addAndMakeVisible (perfInfoLabel);
+
+    // Level meters: self-repainting components instead of full-window paints
+    addAndMakeVisible (inputMeter);
+    addAndMakeVisible (outputMeter);
+
+    inputLevelValueLabel.setColour (juce::Label::textColourId, juce::Colour (0xff00d9ff));
+    inputLevelValueLabel.setFont (juce::FontOptions("Monaco", 12.0f, juce::Font::plain));
+    inputLevelValueLabel.setJustificationType (juce::Justification::centred);
+    addAndMakeVisible (inputLevelValueLabel);
+
+    outputLevelValueLabel.setColour (juce::Label::textColourId, juce::Colour (0xff00ff41));
+    outputLevelValueLabel.setFont (juce::FontOptions("Monaco", 12.0f, juce::Font::plain));
+    outputLevelValueLabel.setJustificationType (juce::Justification::centred);
+    addAndMakeVisible (outputLevelValueLabel);
+
+    addAndMakeVisible (waveformView);
+
+#if PERFORMIA_OPENGL
+    openGLContext.attachTo (*this);
+#endif
+
+    // Restore the last working device setup so the app is audio-ready in
+    // well under a second; the slow 256-channel probe only runs when nothing
+    // is saved or the saved device has gone away
+    juce::PropertiesFile::Options options;
+    options.applicationName = "Performia";
+    options.filenameSuffix = "settings";
+    options.folderName = "Performia";
+    options.osxLibrarySubFolder = "Application Support";
+    appProperties.setStorageParameters (options);
+
+    // Flight recorder: every control change from here on lands in a binary
+    // ring file that survives crashes, unlike DBG output
+    audioEngine.getFlightRecorder().open (
+        juce::File::getSpecialLocation (juce::File::userDocumentsDirectory)
+            .getChildFile ("Performia Logs").getChildFile ("flight.pflt"));
+    audioEngine.getFlightRecorder().log (FlightRecorder::EventType::sessionStart);
+
+    // Performance profile: parsed now, then watched for saves. The engine
+    // re-applies each published snapshot from the callback, so gate and
+    // routing tweaks land mid-set without a restart.
+    audioEngine.getConfigStore().open (
+        juce::File::getSpecialLocation (juce::File::userDocumentsDirectory)
+            .getChildFile ("Performia").getChildFile ("profile.json"));
+    lastConfigVersion = audioEngine.getConfigStore().getVersion();
+
+    std::unique_ptr<juce::XmlElement> savedAudioState;
+
+    if (auto* userSettings = appProperties.getUserSettings())
+    {
+        savedAudioState = userSettings->getXmlValue ("audioDeviceState");
+
+        inputGainSlider.setValue (userSettings->getDoubleValue ("inputGain", 100.0));
+        outputVolumeSlider.setValue (userSettings->getDoubleValue ("outputVolume", 75.0));
+        testFreqSlider.setValue (userSettings->getDoubleValue ("testFrequency", 440.0));
+    }
+
+    auto result = setAudioChannels (256, 2, savedAudioState.get());
+
     if (result.isNotEmpty())
     {
         DBG ("Audio setup error: " << result);
@@ -112,7 +207,8 @@ MainComponent::MainComponent()
     
     // Update device list
     updateDeviceList();
-    
+    refreshDeviceInfo();
+
     // Device selector callbacks
     inputDeviceSelector.onChange = [this] {
         auto selected = inputDeviceSelector.getText();
@@ -127,9 +223,46 @@ MainComponent::MainComponent()
     };
     
     inputChannelSelector.onChange = [this] {
+        const int channel = inputChannelSelector.getSelectedId() - 1;
+        parameters.setSelectedInputChannel (channel);
+
+        // The gain slider edits whichever channel is selected
+        inputGainSlider.setValue (audioEngine.getInputConditioner().getChannelGain (
+                                      juce::jmax (0, channel)) * 100.0,
+                                  juce::dontSendNotification);
+
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::inputChannelChanged, channel);
         logMessage ("Input channel changed to: " + inputChannelSelector.getText());
     };
+
+    secondaryDeviceSelector.onChange = [this] {
+        if (secondaryDeviceSelector.getSelectedId() == 1)
+        {
+            secondaryInput.close();
+            audioEngine.getFlightRecorder().log (FlightRecorder::EventType::secondaryDeviceChanged, 0);
+        }
+        else if (secondaryDeviceSelector.getText() != secondaryInput.getDeviceName())
+        {
+            // open() sets up the resampler itself before publishing the
+            // device as open; calling prepareOutput() here would write the
+            // plain ratio fields under a live audio callback
+            if (secondaryInput.open (secondaryDeviceSelector.getText()))
+            {
+                audioEngine.getFlightRecorder().log (FlightRecorder::EventType::secondaryDeviceChanged, 1);
+                logMessage ("Secondary device: " + secondaryDeviceSelector.getText());
+            }
+            else
+            {
+                secondaryDeviceSelector.setSelectedId (1, juce::dontSendNotification);
+            }
+        }
+    };
     
+    // Bring up the OSC control surface for the agent system, and the
+    // batched per-hop analysis feed back to it
+    oscBridge.connect();
+    audioEngine.getAnalysisPublisher().connect ("127.0.0.1", 9002);
+
     // Start timer for UI updates
     startTimer (30);
     
@@ -146,7 +279,24 @@ MainComponent::MainComponent()
 
 MainComponent::~MainComponent()
 {
+#if PERFORMIA_OPENGL
+    openGLContext.detach();
+#endif
+
     deviceManager.removeChangeListener (this);
+
+    // Persist the working setup for the next launch
+    if (auto* userSettings = appProperties.getUserSettings())
+    {
+        if (auto deviceState = deviceManager.createStateXml())
+            userSettings->setValue ("audioDeviceState", deviceState.get());
+
+        userSettings->setValue ("inputGain", inputGainSlider.getValue());
+        userSettings->setValue ("outputVolume", outputVolumeSlider.getValue());
+        userSettings->setValue ("testFrequency", testFreqSlider.getValue());
+        userSettings->saveIfNeeded();
+    }
+
     shutdownAudio();
     setLookAndFeel (nullptr);
 }
@@ -167,10 +317,28 @@ void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRat
         DBG ("Active input channels: " << device->getActiveInputChannels().toString(2));
         DBG ("Active output channels: " << device->getActiveOutputChannels().toString(2));
     }
+
+    // The engine always sees room for the secondary device's channels after
+    // the main buffer's, so plugging one in never needs an engine re-prepare
+    secondaryChannelOffset = juce::jmax (getTotalNumInputChannels(),
+                                         getTotalNumOutputChannels());
+    aggregateBuffer.setSize (secondaryChannelOffset + SecondaryInput::maxChannels,
+                             samplesPerBlockExpected);
+    secondaryInput.prepareOutput (sampleRate, samplesPerBlockExpected);
+
+    audioEngine.prepare (samplesPerBlockExpected, sampleRate,
+                         secondaryChannelOffset + SecondaryInput::maxChannels,
+                         getTotalNumOutputChannels());
+    callbackMonitor.prepare (sampleRate, samplesPerBlockExpected);
 }
 
 void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
 {
+    // FTZ/DAZ for the whole callback: the conditioner's one-pole filters and
+    // the voice decay tails otherwise end in denormal territory, where every
+    // multiply traps to microcode
+    juce::ScopedNoDenormals noDenormals;
+
     // Always clear the buffer first
     bufferToFill.clearActiveBufferRegion();
     
@@ -181,143 +349,54 @@ void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& buffe
         return;
     }
     
-    // Get buffer info
-    const int numInputChannels = getTotalNumInputChannels();
-    const int numOutputChannels = getTotalNumOutputChannels();
-    const int numSamples = bufferToFill.numSamples;
-    
-    // Debug logging (only occasionally to avoid spam)
-    static int debugCounter = 0;
-    if (++debugCounter > 100)  // Log every ~3 seconds at 30fps
-    {
-        debugCounter = 0;
-        DBG ("=== Audio Callback Debug ===");
-        DBG ("Buffer channels: " << bufferToFill.buffer->getNumChannels());
-        DBG ("Num input channels: " << numInputChannels);
-        DBG ("Num output channels: " << numOutputChannels);
-        DBG ("Num samples: " << numSamples);
-        
-        // Check if we're getting any input signal at all
-        for (int ch = 0; ch < numInputChannels && ch < bufferToFill.buffer->getNumChannels(); ++ch)
-        {
-            auto* data = bufferToFill.buffer->getReadPointer(ch, bufferToFill.startSample);
-            float sum = 0.0f;
-            for (int i = 0; i < numSamples; ++i)
-                sum += std::abs(data[i]);
-            
-            if (sum > 0.0f)
-                DBG ("Channel " << ch << " has signal: " << sum);
-        }
-    }
-    
-    // Get selected input channel
-    int selectedInputChannel = inputChannelSelector.getSelectedId() - 1;
-    if (selectedInputChannel < 0) selectedInputChannel = 0;
-    
-    // Try all channels if selected channel has no signal
-    float maxInput = 0.0f;
-    int activeChannel = -1;
-    
-    // First try selected channel
-    if (selectedInputChannel < numInputChannels && 
-        selectedInputChannel < bufferToFill.buffer->getNumChannels())
-    {
-        auto* inputData = bufferToFill.buffer->getReadPointer(selectedInputChannel, 
-                                                              bufferToFill.startSample);
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float sample = std::abs(inputData[i]);
-            if (sample > maxInput) 
-            {
-                maxInput = sample;
-                activeChannel = selectedInputChannel;
-            }
-        }
-    }
-    
-    // If no signal on selected channel, scan all channels
-    if (maxInput < 0.0001f)  // Threshold for "no signal"
-    {
-        for (int ch = 0; ch < numInputChannels && ch < bufferToFill.buffer->getNumChannels(); ++ch)
-        {
-            auto* inputData = bufferToFill.buffer->getReadPointer(ch, bufferToFill.startSample);
-            for (int i = 0; i < numSamples; ++i)
-            {
-                float sample = std::abs(inputData[i]);
-                if (sample > maxInput)
-                {
-                    maxInput = sample;
-                    activeChannel = ch;
-                }
-            }
-        }
-        
-        // If we found signal on a different channel, log it
-        if (activeChannel >= 0 && activeChannel != selectedInputChannel)
-        {
-            DBG ("Signal detected on channel " << (activeChannel + 1) << " instead of selected channel " << (selectedInputChannel + 1));
-        }
-    }
-    
-    // Apply gain
-    float gain = (float)(inputGainSlider.getValue() / 50.0);
-    inputLevel = maxInput * gain;
-    
-    // Output section
-    float outputGain = (float)(outputVolumeSlider.getValue() / 100.0);
-    float maxOutput = 0.0f;
-    
-    // Generate test tone
-    if (testToneActive)
+    // Pull a coherent, wait-free parameter snapshot and hand everything to
+    // the engine. All DSP (channel scanning, gain, synthesis, monitoring)
+    // lives in the AudioEngine graph so this callback stays a thin shim.
+    const EngineState state = parameters.read();
+
+    callbackMonitor.beginBlock();
+
+    if (secondaryInput.isOpen()
+         && bufferToFill.numSamples <= aggregateBuffer.getNumSamples())
     {
-        const double cyclesPerSample = testToneFrequency / currentSampleRate;
-        
-        for (int channel = 0; channel < numOutputChannels && channel < bufferToFill.buffer->getNumChannels(); ++channel)
-        {
-            auto* outputData = bufferToFill.buffer->getWritePointer(channel, bufferToFill.startSample);
-            
-            double phase = testTonePhase;
-            for (int sample = 0; sample < numSamples; ++sample)
-            {
-                float currentSample = (float)std::sin(2.0 * juce::MathConstants<double>::pi * phase);
-                currentSample *= outputGain * 0.3f;
-                outputData[sample] = currentSample;
-                
-                phase += cyclesPerSample;
-                if (phase >= 1.0) phase -= 1.0;
-                
-                float absSample = std::abs(currentSample);
-                if (absSample > maxOutput) maxOutput = absSample;
-            }
-        }
-        testTonePhase = std::fmod(testTonePhase + cyclesPerSample * numSamples, 1.0);
+        // Aggregate path: main device channels plus the secondary device's
+        // ring, resampled onto this callback's clock, in one wide buffer
+        const int mainChannels = juce::jmin (bufferToFill.buffer->getNumChannels(),
+                                             secondaryChannelOffset);
+
+        for (int channel = 0; channel < mainChannels; ++channel)
+            aggregateBuffer.copyFrom (channel, 0, *bufferToFill.buffer, channel,
+                                      bufferToFill.startSample, bufferToFill.numSamples);
+
+        for (int channel = mainChannels; channel < aggregateBuffer.getNumChannels(); ++channel)
+            aggregateBuffer.clear (channel, 0, bufferToFill.numSamples);
+
+        secondaryInput.pullBlock (aggregateBuffer, secondaryChannelOffset,
+                                  0, bufferToFill.numSamples);
+
+        audioEngine.process (aggregateBuffer, 0, bufferToFill.numSamples, state);
+
+        for (int channel = 0; channel < mainChannels; ++channel)
+            bufferToFill.buffer->copyFrom (channel, bufferToFill.startSample,
+                                           aggregateBuffer, channel,
+                                           0, bufferToFill.numSamples);
     }
-    // Input monitoring - use the channel where we found signal
-    else if (inputMonitoring && activeChannel >= 0)
+    else
     {
-        auto* inputData = bufferToFill.buffer->getReadPointer(activeChannel, bufferToFill.startSample);
-        
-        for (int channel = 0; channel < numOutputChannels && channel < bufferToFill.buffer->getNumChannels(); ++channel)
-        {
-            auto* outputData = bufferToFill.buffer->getWritePointer(channel, bufferToFill.startSample);
-            
-            for (int i = 0; i < numSamples; ++i)
-            {
-                float sample = inputData[i] * gain * outputGain;
-                outputData[i] = sample;
-                
-                float absSample = std::abs(sample);
-                if (absSample > maxOutput) maxOutput = absSample;
-            }
-        }
+        audioEngine.process (*bufferToFill.buffer, bufferToFill.startSample,
+                             bufferToFill.numSamples, state);
     }
-    
-    outputLevel = maxOutput;
+
+    callbackMonitor.endBlock();
+
+    inputLevel = audioEngine.getInputLevel();
+    outputLevel = audioEngine.getOutputLevel();
 }
 
 void MainComponent::releaseResources()
 {
     DBG ("releaseResources called");
+    audioEngine.release();
 }
 
 void MainComponent::changeListenerCallback (juce::ChangeBroadcaster* source)
@@ -328,18 +407,39 @@ void MainComponent::changeListenerCallback (juce::ChangeBroadcaster* source)
         
         updateDeviceList();
         updateChannelSelector();
-        
+
+        // Channel counts in the chrome may have changed
+        backgroundCache = juce::Image();
+        repaint();
+
+        // Remember every working setup so a crash recovery restores the
+        // device the performer was actually using
+        if (auto* userSettings = appProperties.getUserSettings())
+        {
+            if (auto deviceState = deviceManager.createStateXml())
+            {
+                userSettings->setValue ("audioDeviceState", deviceState.get());
+                userSettings->saveIfNeeded();
+            }
+        }
+
         if (auto* device = deviceManager.getCurrentAudioDevice())
         {
             currentSampleRate = device->getCurrentSampleRate();
             currentBufferSize = device->getCurrentBufferSizeSamples();
-            
+
+            audioEngine.getFlightRecorder().log (FlightRecorder::EventType::deviceChanged, 0,
+                                                 (float) currentSampleRate,
+                                                 (float) currentBufferSize);
+
             DBG ("New device: " << device->getName());
             DBG ("Sample rate: " << currentSampleRate);
             DBG ("Buffer size: " << currentBufferSize);
             DBG ("Input channels: " << device->getActiveInputChannels().toString(2));
             DBG ("Output channels: " << device->getActiveOutputChannels().toString(2));
         }
+
+        refreshDeviceInfo();
     }
 }
 
@@ -352,12 +452,15 @@ void MainComponent::buttonClicked (juce::Button* button)
         powerButton.setColour (juce::TextButton::buttonColourId, 
                               systemOn ? juce::Colour (0xff00ff41) : juce::Colour (0xff1a1a1a));
         
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::powerToggled, systemOn ? 1 : 0);
         DBG ("System power: " << (systemOn ? "ON" : "OFF"));
         
         if (!systemOn)
         {
             testToneActive = false;
             inputMonitoring = false;
+            parameters.setTestToneActive (false);
+            parameters.setInputMonitoring (false);
             testToneButton.setButtonText ("TEST TONE OFF");
             testToneButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
             inputMonitorButton.setButtonText ("MONITOR OFF");
@@ -367,6 +470,7 @@ void MainComponent::buttonClicked (juce::Button* button)
     else if (button == &testToneButton)
     {
         testToneActive = !testToneActive;
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::testToneToggled, testToneActive ? 1 : 0);
         testToneButton.setButtonText (testToneActive ? "TEST TONE ON" : "TEST TONE OFF");
         testToneButton.setColour (juce::TextButton::buttonColourId, 
                                  testToneActive ? juce::Colour (0xffffd600) : juce::Colour (0xff1a1a1a));
@@ -377,10 +481,14 @@ void MainComponent::buttonClicked (juce::Button* button)
             inputMonitorButton.setButtonText ("MONITOR OFF");
             inputMonitorButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
         }
+
+        parameters.setTestToneActive (testToneActive);
+        parameters.setInputMonitoring (inputMonitoring);
     }
     else if (button == &inputMonitorButton)
     {
         inputMonitoring = !inputMonitoring;
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::monitorToggled, inputMonitoring ? 1 : 0);
         inputMonitorButton.setButtonText (inputMonitoring ? "MONITOR ON" : "MONITOR OFF");
         inputMonitorButton.setColour (juce::TextButton::buttonColourId, 
                                      inputMonitoring ? juce::Colour (0xff00d9ff) : juce::Colour (0xff1a1a1a));
@@ -393,6 +501,48 @@ void MainComponent::buttonClicked (juce::Button* button)
             testToneButton.setButtonText ("TEST TONE OFF");
             testToneButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
         }
+
+        parameters.setTestToneActive (testToneActive);
+        parameters.setInputMonitoring (inputMonitoring);
+    }
+    else if (button == &recordButton)
+    {
+        auto& recorder = audioEngine.getRecorder();
+
+        if (recorder.isRecording())
+        {
+            recorder.stopRecording();
+            audioEngine.getFlightRecorder().log (FlightRecorder::EventType::recordingToggled, 0);
+            recordButton.setButtonText ("RECORD OFF");
+            recordButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xff1a1a1a));
+        }
+        else
+        {
+            auto dir = juce::File::getSpecialLocation (juce::File::userDocumentsDirectory)
+                           .getChildFile ("Performia Recordings");
+            dir.createDirectory();
+
+            auto file = dir.getChildFile ("performia_"
+                            + juce::Time::getCurrentTime().formatted ("%Y%m%d_%H%M%S")
+                            + ".prfm");
+
+            if (recorder.startRecording (file))
+            {
+                audioEngine.getFlightRecorder().log (FlightRecorder::EventType::recordingToggled, 1);
+                recordButton.setButtonText ("RECORDING");
+                recordButton.setColour (juce::TextButton::buttonColourId, juce::Colour (0xffff0000));
+                logMessage ("Recording to " + file.getFullPathName());
+            }
+            else
+            {
+                logMessage ("Could not start recording to " + file.getFullPathName());
+            }
+        }
+    }
+    else if (button == &measureLatencyButton)
+    {
+        logMessage ("Measuring round-trip latency - patch an output into the selected input");
+        audioEngine.getLatencyProbe().startMeasurement();
     }
     else if (button == &showAudioSettingsButton)
     {
@@ -430,45 +580,44 @@ void MainComponent::buttonClicked (juce::Button* button)
 //==============================================================================
 void MainComponent::paint (juce::Graphics& g)
 {
-    g.fillAll (juce::Colour (0xff0a0a0a));
-    
-    // Title
-    g.setColour (juce::Colours::white);
-    g.setFont (juce::FontOptions("Monaco", 36.0f, juce::Font::bold));
-    g.drawText ("PERFORMIA", 20, 20, 300, 40, juce::Justification::left);
-    
-    g.setColour (juce::Colour (0xff00d9ff));
-    g.drawText ("AUDIO I/O TEST", 320, 20, 400, 40, juce::Justification::left);
-    
-    // Draw level meters
-    auto inputMeterBounds = juce::Rectangle<float> (500.0f, 300.0f, 40.0f, 250.0f);
-    auto outputMeterBounds = juce::Rectangle<float> (850.0f, 300.0f, 40.0f, 250.0f);
-    
-    drawLevelMeter (g, inputMeterBounds, smoothedInputLevel, inputPeakHold, true);
-    drawLevelMeter (g, outputMeterBounds, smoothedOutputLevel, outputPeakHold, false);
-    
-    // Labels for meters
-    g.setColour (juce::Colour (0xff606060));
-    g.setFont (juce::FontOptions("Monaco", 12.0f, juce::Font::plain));
-    g.drawText ("INPUT", 480, 560, 80, 20, juce::Justification::centred);
-    g.drawText ("OUTPUT", 830, 560, 80, 20, juce::Justification::centred);
-    
-    // Level values
-    g.setColour (juce::Colour (0xff00d9ff));
-    g.drawText (juce::String((int)(smoothedInputLevel * 100)) + "%", 
-               480, 580, 80, 20, juce::Justification::centred);
-    
-    g.setColour (juce::Colour (0xff00ff41));
-    g.drawText (juce::String((int)(smoothedOutputLevel * 100)) + "%", 
-               830, 580, 80, 20, juce::Justification::centred);
-    
-    // Debug info at bottom
-    g.setColour (juce::Colour (0xff404040));
-    g.setFont (juce::FontOptions("Monaco", 10.0f, juce::Font::plain));
-    
-    juce::String debugInfo = "Channels In: " + juce::String(getTotalNumInputChannels()) + 
-                            " | Out: " + juce::String(getTotalNumOutputChannels());
-    g.drawText (debugInfo, 20, getHeight() - 25, 400, 20, juce::Justification::left);
+    // All moving parts (meters, level values) are child components now, so
+    // this only runs for the static chrome - and even that comes out of a
+    // cached image rebuilt on resize or device changes
+    if (! backgroundCache.isValid()
+         || backgroundCache.getWidth() != getWidth()
+         || backgroundCache.getHeight() != getHeight())
+    {
+        backgroundCache = juce::Image (juce::Image::ARGB,
+                                       juce::jmax (1, getWidth()),
+                                       juce::jmax (1, getHeight()), true);
+        juce::Graphics bg (backgroundCache);
+
+        bg.fillAll (juce::Colour (0xff0a0a0a));
+
+        // Title
+        bg.setColour (juce::Colours::white);
+        bg.setFont (juce::FontOptions("Monaco", 36.0f, juce::Font::bold));
+        bg.drawText ("PERFORMIA", 20, 20, 300, 40, juce::Justification::left);
+
+        bg.setColour (juce::Colour (0xff00d9ff));
+        bg.drawText ("AUDIO I/O TEST", 320, 20, 400, 40, juce::Justification::left);
+
+        // Labels for meters
+        bg.setColour (juce::Colour (0xff606060));
+        bg.setFont (juce::FontOptions("Monaco", 12.0f, juce::Font::plain));
+        bg.drawText ("INPUT", 480, 560, 80, 20, juce::Justification::centred);
+        bg.drawText ("OUTPUT", 830, 560, 80, 20, juce::Justification::centred);
+
+        // Debug info at bottom
+        bg.setColour (juce::Colour (0xff404040));
+        bg.setFont (juce::FontOptions("Monaco", 10.0f, juce::Font::plain));
+
+        juce::String debugInfo = "Channels In: " + juce::String(getTotalNumInputChannels()) +
+                                " | Out: " + juce::String(getTotalNumOutputChannels());
+        bg.drawText (debugInfo, 20, getHeight() - 25, 400, 20, juce::Justification::left);
+    }
+
+    g.drawImageAt (backgroundCache, 0, 0);
 }
 
 void MainComponent::resized()
@@ -487,13 +636,18 @@ void MainComponent::resized()
     
     inputChannelLabel.setBounds (20, 250, 120, 20);
     inputChannelSelector.setBounds (20, 270, 200, 25);
+
+    secondaryDeviceLabel.setBounds (240, 250, 150, 20);
+    secondaryDeviceSelector.setBounds (240, 270, 200, 25);
     
     // Controls
     testToneButton.setBounds (20, 320, 140, 40);
     inputMonitorButton.setBounds (170, 320, 140, 40);
+    recordButton.setBounds (320, 320, 120, 40);
     
     testFreqLabel.setBounds (20, 370, 100, 20);
     testFreqSlider.setBounds (20, 390, 290, 30);
+    measureLatencyButton.setBounds (320, 385, 120, 40);
     
     inputGainLabel.setBounds (20, 430, 100, 20);
     inputGainSlider.setBounds (20, 450, 420, 30);
@@ -502,11 +656,33 @@ void MainComponent::resized()
     outputVolumeSlider.setBounds (20, 510, 420, 30);
     
     statusLabel.setBounds (20, 560, 400, 30);
-    deviceInfoLabel.setBounds (20, 590, 420, 250);
+    deviceInfoLabel.setBounds (20, 590, 420, 230);
+    perfInfoLabel.setBounds (20, 825, 420, 20);
+
+    // Level meters and their value readouts
+    inputMeter.setBounds (500, 300, 40, 250);
+    outputMeter.setBounds (850, 300, 40, 250);
+    inputLevelValueLabel.setBounds (480, 580, 80, 20);
+    outputLevelValueLabel.setBounds (830, 580, 80, 20);
+
+    // Per-channel strip between the main meters
+    for (int i = 0; i < channelMeters.size(); ++i)
+        channelMeters.getUnchecked (i)->setBounds (560 + i * 12, 300, 10, 250);
+
+    waveformView.setBounds (910, 300, 470, 250);
 }
 
 void MainComponent::timerCallback()
 {
+    // Drain channel-activity notifications queued by the audio thread
+    int fallbackChannel = 0;
+    while (audioEngine.getActivityMap().popNotification (fallbackChannel))
+    {
+        logMessage ("Signal detected on channel " + juce::String (fallbackChannel + 1)
+                    + " instead of selected channel "
+                    + juce::String (inputChannelSelector.getSelectedId()));
+    }
+
     // Smooth level meters
     smoothedInputLevel = smoothedInputLevel * 0.8f + inputLevel.load() * 0.2f;
     smoothedOutputLevel = smoothedOutputLevel * 0.8f + outputLevel.load() * 0.2f;
@@ -532,97 +708,128 @@ void MainComponent::timerCallback()
         outputPeakHold *= 0.95f;
     }
     
-    // Update status
-    if (systemOn)
+    // Update status. Everything the timer writes goes through the cached
+    // formatters: fixed stack buffers, snprintf, and a Label touch only on
+    // an actual change, so a steady-state tick allocates nothing.
+    if (statusText.update (statusLabel, "STATUS: %s", systemOn ? "ONLINE" : "OFFLINE"))
+        statusLabel.setColour (juce::Label::textColourId,
+                               systemOn ? juce::Colour (0xff00ff41) : juce::Colour (0xffff006e));
+
+    // The device description is rebuilt only when the device actually
+    // changes (refreshDeviceInfo); the timer touches just the volatile bits
+    const auto xruns = callbackMonitor.getXRunCount();
+    perfText.update (perfInfoLabel, "DSP Load: %.1f%% | p99: %.2f ms | XRuns: %u",
+                     callbackMonitor.getLastLoad() * 100.0f,
+                     callbackMonitor.getPercentileMs (0.99),
+                     (unsigned int) xruns);
+
+    // Any xruns since the last tick go into the flight recorder
+    if (xruns != lastXRunCount)
     {
-        statusLabel.setText ("STATUS: ONLINE", juce::dontSendNotification);
-        statusLabel.setColour (juce::Label::textColourId, juce::Colour (0xff00ff41));
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::xrun, (int) xruns);
+        lastXRunCount = xruns;
     }
-    else
+
+    // Profile saves picked up by the config watcher
+    const auto configVersion = audioEngine.getConfigStore().getVersion();
+    if (configVersion != lastConfigVersion)
     {
-        statusLabel.setText ("STATUS: OFFLINE", juce::dontSendNotification);
-        statusLabel.setColour (juce::Label::textColourId, juce::Colour (0xffff006e));
+        audioEngine.getFlightRecorder().log (FlightRecorder::EventType::configReloaded,
+                                             (int) configVersion);
+        logMessage ("Profile reloaded (v" + juce::String ((int) configVersion) + ")");
+        lastConfigVersion = configVersion;
     }
-    
-    // Update device info
-    if (auto* device = deviceManager.getCurrentAudioDevice())
+
+    // Each meter repaints only the rows that moved; labels repaint themselves
+    // only when their text changes. No full-window repaint here.
+    inputMeter.setLevels (smoothedInputLevel, inputPeakHold);
+    outputMeter.setLevels (smoothedOutputLevel, outputPeakHold);
+
+    inputLevelText.update (inputLevelValueLabel, "%d%%", (int) (smoothedInputLevel * 100));
+    outputLevelText.update (outputLevelValueLabel, "%d%%", (int) (smoothedOutputLevel * 100));
+
+    const auto& meters = audioEngine.getMeters();
+    for (int i = 0; i < channelMeters.size(); ++i)
+        channelMeters.getUnchecked (i)->setLevels (meters.getPeak (i), 0.0f);
+
+    // Pick up latency probe completion; the result lives in the device panel
+    auto& probe = audioEngine.getLatencyProbe();
+    const auto probeState = probe.getState();
+
+    if (probeState != lastProbeState)
     {
-        juce::String info;
-        info << "Current Device: " << device->getName() << "\n";
-        info << "Type: " << device->getTypeName() << "\n";
-        info << "Sample Rate: " << currentSampleRate << " Hz\n";
-        info << "Buffer Size: " << currentBufferSize << " samples\n";
-        info << "Latency: " << juce::String((currentBufferSize * 1000.0) / currentSampleRate, 1) << " ms\n";
-        
-        auto inputChannels = device->getActiveInputChannels();
-        auto outputChannels = device->getActiveOutputChannels();
-        
-        info << "Input Channels Active: " << inputChannels.countNumberOfSetBits();
-        info << " [" << inputChannels.toString(2) << "]\n";
-        info << "Output Channels Active: " << outputChannels.countNumberOfSetBits();
-        info << " [" << outputChannels.toString(2) << "]\n";
-        
-        info << "\nTotal Channels Available:\n";
-        info << "Inputs: " << getTotalNumInputChannels() << "\n";
-        info << "Outputs: " << getTotalNumOutputChannels();
-        
-        deviceInfoLabel.setText (info, juce::dontSendNotification);
+        if (probeState == LatencyProbe::State::done)
+        {
+            audioEngine.getFlightRecorder().log (FlightRecorder::EventType::latencyMeasured,
+                                                 probe.getRoundTripSamples(),
+                                                 (float) probe.getRoundTripMs());
+            logMessage ("Round-trip latency: " + juce::String (probe.getRoundTripSamples())
+                        + " samples (" + juce::String (probe.getRoundTripMs(), 2) + " ms)");
+            refreshDeviceInfo();
+        }
+        else if (probeState == LatencyProbe::State::failed)
+        {
+            audioEngine.getFlightRecorder().log (FlightRecorder::EventType::latencyMeasured, -1);
+            logMessage ("Latency measurement failed - no loopback signal detected");
+            refreshDeviceInfo();
+        }
+
+        lastProbeState = probeState;
     }
-    
-    repaint();
 }
 
 void MainComponent::updateDeviceList()
 {
-    auto* audioDeviceManager = &deviceManager;
-    
-    inputDeviceSelector.clear();
-    outputDeviceSelector.clear();
-    
-    // Get current setup
-    auto setup = audioDeviceManager->getAudioDeviceSetup();
-    
-    DBG ("Current setup - Input: " << setup.inputDeviceName << ", Output: " << setup.outputDeviceName);
-    
-    // Get available device types
-    juce::OwnedArray<juce::AudioIODeviceType> types;
-    audioDeviceManager->createAudioDeviceTypes (types);
-    
+    // Populate instantly from the cached snapshot; the scanner refreshes the
+    // cache in the background and repopulates the selectors when done
+    populateDeviceSelectors();
+
+    deviceScanner.refreshAsync ([this] { populateDeviceSelectors(); });
+}
+
+void MainComponent::populateDeviceSelectors()
+{
+    auto snapshot = deviceScanner.getCachedSnapshot();
+    auto setup = deviceManager.getAudioDeviceSetup();
+
+    inputDeviceSelector.clear (juce::dontSendNotification);
+    outputDeviceSelector.clear (juce::dontSendNotification);
+
     int inputId = 1;
+    for (auto& device : snapshot.inputDevices)
+    {
+        inputDeviceSelector.addItem (device, inputId);
+        if (device == setup.inputDeviceName)
+            inputDeviceSelector.setSelectedId (inputId, juce::dontSendNotification);
+        inputId++;
+    }
+
     int outputId = 1;
-    
-    for (auto* type : types)
+    for (auto& device : snapshot.outputDevices)
     {
-        DBG ("Scanning device type: " << type->getTypeName());
-        type->scanForDevices();
-        
-        // Input devices
-        auto inputDevices = type->getDeviceNames (true);
-        DBG ("Found " << inputDevices.size() << " input devices");
-        
-        for (auto& device : inputDevices)
-        {
-            DBG ("  Input: " << device);
-            inputDeviceSelector.addItem (device, inputId);
-            if (device == setup.inputDeviceName)
-                inputDeviceSelector.setSelectedId (inputId);
-            inputId++;
-        }
-        
-        // Output devices  
-        auto outputDevices = type->getDeviceNames (false);
-        DBG ("Found " << outputDevices.size() << " output devices");
-        
-        for (auto& device : outputDevices)
-        {
-            DBG ("  Output: " << device);
-            outputDeviceSelector.addItem (device, outputId);
-            if (device == setup.outputDeviceName)
-                outputDeviceSelector.setSelectedId (outputId);
-            outputId++;
-        }
+        outputDeviceSelector.addItem (device, outputId);
+        if (device == setup.outputDeviceName)
+            outputDeviceSelector.setSelectedId (outputId, juce::dontSendNotification);
+        outputId++;
     }
-    
+
+    // Secondary slot: any input device except the primary one
+    secondaryDeviceSelector.clear (juce::dontSendNotification);
+    secondaryDeviceSelector.addItem ("None", 1);
+    secondaryDeviceSelector.setSelectedId (1, juce::dontSendNotification);
+
+    int secondaryId = 2;
+    for (auto& device : snapshot.inputDevices)
+    {
+        if (device == setup.inputDeviceName)
+            continue;
+
+        secondaryDeviceSelector.addItem (device, secondaryId);
+        if (device == secondaryInput.getDeviceName())
+            secondaryDeviceSelector.setSelectedId (secondaryId, juce::dontSendNotification);
+        secondaryId++;
+    }
+
     updateChannelSelector();
 }
 
@@ -677,201 +884,64 @@ void MainComponent::updateChannelSelector()
     
     if (numInputs > 0)
         inputChannelSelector.setSelectedId (1);
-}
 
-void MainComponent::logMessage (const juce::String& message)
-{
-    DBG (message);
+    rebuildChannelMeters();
 }
 
-void MainComponent::drawLevelMeter (juce::Graphics& g, juce::Rectangle<float> bounds, 
-                                   float level, float peakHold, bool isInput)
+void MainComponent::refreshDeviceInfo()
 {
-    // Background
-    g.setColour (juce::Colour (0xff1a1a1a));
-    g.fillRoundedRectangle (bounds, 5.0f);
-    
-    // Level bar
-    auto meterHeight = bounds.getHeight() * juce::jlimit (0.0f, 1.0f, level);
-    auto meterBounds = bounds.removeFromBottom (meterHeight);
-    
-    // Color based on level
-    if (level > 0.9f)
-        g.setColour (juce::Colour (0xffff0000));
-    else if (level > 0.7f)
-        g.setColour (juce::Colour (0xffffd600));
-    else
-        g.setColour (isInput ? juce::Colour (0xff00d9ff) : juce::Colour (0xff00ff41));
-    
-    g.fillRoundedRectangle (meterBounds, 5.0f);
-    
-    // Peak hold line
-    if (peakHold > 0.01f)
+    // Building this string walks 256-bit channel masks, so it only runs on
+    // actual device changes, never from the 30ms timer
+    if (auto* device = deviceManager.getCurrentAudioDevice())
     {
-        float peakY = bounds.getBottom() - (bounds.getHeight() * peakHold);
-        g.setColour (juce::Colours::white);
-        g.drawLine (bounds.getX(), peakY, bounds.getRight(), peakY, 2.0f);
-    }
-}
+        juce::String info;
+        info << "Current Device: " << device->getName() << "\n";
+        info << "Type: " << device->getTypeName() << "\n";
+        info << "Sample Rate: " << currentSampleRate << " Hz\n";
+        info << "Buffer Size: " << currentBufferSize << " samples\n";
         info << "Latency: " << juce::String((currentBufferSize * 1000.0) / currentSampleRate, 1) << " ms\n";
-        
+
         auto inputChannels = device->getActiveInputChannels();
         auto outputChannels = device->getActiveOutputChannels();
-        
+
         info << "Input Channels Active: " << inputChannels.countNumberOfSetBits();
         info << " [" << inputChannels.toString(2) << "]\n";
         info << "Output Channels Active: " << outputChannels.countNumberOfSetBits();
         info << " [" << outputChannels.toString(2) << "]\n";
-        
-        info << "\nBuffer Info:\n";
-        info << "Available buffer sizes: ";
-        auto bufferSizes = device->getAvailableBufferSizes();
-        if (bufferSizes.size() > 0)
-        {
-            for (auto size : bufferSizes)
-                info << size << " ";
-        }
-        else
-        {
-            info << "Not specified";
-        }
-        
+
+        info << "\nTotal Channels Available:\n";
+        info << "Inputs: " << getTotalNumInputChannels() << "\n";
+        info << "Outputs: " << getTotalNumOutputChannels();
+
+        // Measured round-trip beats the buffer-size estimate above: it
+        // includes driver, converter and safety-buffer latency
+        auto& probe = audioEngine.getLatencyProbe();
+
+        if (probe.getState() == LatencyProbe::State::done)
+            info << "\nMeasured Round-Trip: " << probe.getRoundTripSamples()
+                 << " samples (" << juce::String (probe.getRoundTripMs(), 2) << " ms)";
+        else if (probe.getState() == LatencyProbe::State::failed)
+            info << "\nMeasured Round-Trip: failed (no loopback signal)";
+
         deviceInfoLabel.setText (info, juce::dontSendNotification);
     }
-    
-    repaint();
 }
 
-void MainComponent::updateDeviceList()
+void MainComponent::rebuildChannelMeters()
 {
-    auto* audioDeviceManager = &deviceManager;
-    
-    inputDeviceSelector.clear();
-    outputDeviceSelector.clear();
-    
-    // Get current setup
-    auto setup = audioDeviceManager->getAudioDeviceSetup();
-    
-    DBG ("Current setup - Input: " << setup.inputDeviceName << ", Output: " << setup.outputDeviceName);
-    
-    // Get available device types
-    juce::OwnedArray<juce::AudioIODeviceType> types;
-    audioDeviceManager->createAudioDeviceTypes (types);
-    
-    int inputId = 1;
-    int outputId = 1;
-    
-    for (auto* type : types)
-    {
-        DBG ("Scanning device type: " << type->getTypeName());
-        type->scanForDevices();
-        
-        // Input devices
-        auto inputDevices = type->getDeviceNames (true);
-        DBG ("Found " << inputDevices.size() << " input devices");
-        
-        for (auto& device : inputDevices)
-        {
-            DBG ("  Input: " << device);
-            inputDeviceSelector.addItem (device, inputId);
-            if (device == setup.inputDeviceName)
-                inputDeviceSelector.setSelectedId (inputId);
-            inputId++;
-        }
-        
-        // Output devices  
-        auto outputDevices = type->getDeviceNames (false);
-        DBG ("Found " << outputDevices.size() << " output devices");
-        
-        for (auto& device : outputDevices)
-        {
-            DBG ("  Output: " << device);
-            outputDeviceSelector.addItem (device, outputId);
-            if (device == setup.outputDeviceName)
-                outputDeviceSelector.setSelectedId (outputId);
-            outputId++;
-        }
-    }
-    
-    updateChannelSelector();
-}
+    // One narrow meter per device input channel, capped so a 64-channel
+    // interface doesn't swallow the layout
+    const int metersToShow = juce::jmin (getTotalNumInputChannels(), 24);
 
-void MainComponent::setAudioDevice (const juce::String& deviceName, bool isInput)
-{
-    auto setup = deviceManager.getAudioDeviceSetup();
-    
-    if (isInput)
-    {
-        setup.inputDeviceName = deviceName;
-        setup.useDefaultInputChannels = false;
-        // Enable ALL input channels
-        setup.inputChannels.clear();
-        setup.inputChannels.setRange (0, 256, true);  // Enable many channels
-    }
-    else
-    {
-        setup.outputDeviceName = deviceName;
-        setup.useDefaultOutputChannels = true;
-    }
-    
-    DBG ("Setting " << (isInput ? "input" : "output") << " device to: " << deviceName);
-    
-    juce::String error = deviceManager.setAudioDeviceSetup (setup, true);
-    
-    if (error.isNotEmpty())
-    {
-        DBG ("Error setting device: " << error);
-        // Try again with default channels
-        if (isInput)
-        {
-            setup.useDefaultInputChannels = true;
-            setup.inputChannels.clear();
-        }
-        error = deviceManager.setAudioDeviceSetup (setup, true);
-        
-        if (error.isNotEmpty())
-        {
-            DBG ("Second attempt failed: " << error);
-        }
-    }
-    else
-    {
-        DBG ("Device set successfully");
-        
-        // Verify the change
-        if (auto* device = deviceManager.getCurrentAudioDevice())
-        {
-            DBG ("Verified device: " << device->getName());
-            DBG ("Input channels: " << device->getActiveInputChannels().toString(2));
-            DBG ("Output channels: " << device->getActiveOutputChannels().toString(2));
-        }
-    }
-}
+    if (channelMeters.size() == metersToShow)
+        return;
 
-void MainComponent::updateChannelSelector()
-{
-    inputChannelSelector.clear();
-    
-    if (auto* device = deviceManager.getCurrentAudioDevice())
-    {
-        auto activeInputs = device->getActiveInputChannels();
-        int numInputs = activeInputs.countNumberOfSetBits();
-        
-        DBG ("Updating channel selector with " << numInputs << " active channels");
-        DBG ("Channel bits: " << activeInputs.toString(2));
-        
-        int id = 1;
-        for (int i = 0; i < activeInputs.size(); ++i)
-        {
-            if (activeInputs[i])
-            {
-                inputChannelSelector.addItem ("Channel " + juce::String(i + 1), id++);
-            }
-        }
-        
-        if (inputChannelSelector.getNumItems() > 0)
-            inputChannelSelector.setSelectedId (1);
-    }
+    channelMeters.clear();
+    for (int i = 0; i < metersToShow; ++i)
+        addAndMakeVisible (channelMeters.add (
+            new LevelMeterComponent (LevelMeterComponent::Style::input)));
+
+    resized();
 }
 
 void MainComponent::logMessage (const juce::String& message)
@@ -879,32 +949,3 @@ void MainComponent::logMessage (const juce::String& message)
     DBG (message);
 }
 
-void MainComponent::drawLevelMeter (juce::Graphics& g, juce::Rectangle<float> bounds, 
-                                   float level, float peakHold, bool isInput)
-{
-    // Background
-    g.setColour (juce::Colour (0xff1a1a1a));
-    g.fillRoundedRectangle (bounds, 5.0f);
-    
-    // Level bar
-    auto meterHeight = bounds.getHeight() * juce::jlimit (0.0f, 1.0f, level);
-    auto meterBounds = bounds.removeFromBottom (meterHeight);
-    
-    // Color based on level
-    if (level > 0.9f)
-        g.setColour (juce::Colour (0xffff0000));
-    else if (level > 0.7f)
-        g.setColour (juce::Colour (0xffffd600));
-    else
-        g.setColour (isInput ? juce::Colour (0xff00d9ff) : juce::Colour (0xff00ff41));
-    
-    g.fillRoundedRectangle (meterBounds, 5.0f);
-    
-    // Peak hold line
-    if (peakHold > 0.01f)
-    {
-        float peakY = bounds.getBottom() - (bounds.getHeight() * peakHold);
-        g.setColour (juce::Colours::white);
-        g.drawLine (bounds.getX(), peakY, bounds.getRight(), peakY, 2.0f);
-    }
-}
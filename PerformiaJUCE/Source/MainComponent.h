@@ -1,6 +1,19 @@
 #pragma once
 
-#include <JuceHeader.h>
+#include <juce_audio_utils/juce_audio_utils.h>
+#if PERFORMIA_OPENGL
+ #include <juce_opengl/juce_opengl.h>
+#endif
+#include "AudioEngine.h"
+#include "LevelMeterComponent.h"
+#include "WaveformComponent.h"
+#include "CachedLabelText.h"
+#include "ParameterStore.h"
+#include "OscBridge.h"
+#include "MidiPedalInput.h"
+#include "DeviceScanner.h"
+#include "SecondaryInput.h"
+#include "CallbackMonitor.h"
 
 //==============================================================================
 class MainComponent : public juce::AudioAppComponent,
@@ -36,6 +49,8 @@ private:
     juce::TextButton powerButton {"SYSTEM OFF"};
     juce::TextButton testToneButton {"TEST TONE OFF"};
     juce::TextButton inputMonitorButton {"MONITOR OFF"};
+    juce::TextButton recordButton {"RECORD OFF"};
+    juce::TextButton measureLatencyButton {"MEASURE LATENCY"};
     
     juce::Slider inputGainSlider;
     juce::Slider outputVolumeSlider;
@@ -46,6 +61,7 @@ private:
     juce::Label testFreqLabel;
     juce::Label statusLabel;
     juce::Label deviceInfoLabel;
+    juce::Label perfInfoLabel;
     
     // Combo boxes for direct device selection
     juce::ComboBox inputDeviceSelector;
@@ -56,8 +72,28 @@ private:
     // Channel selectors
     juce::ComboBox inputChannelSelector;
     juce::Label inputChannelLabel;
+
+    // Secondary capture device (aggregated through a drift-compensated ring)
+    juce::ComboBox secondaryDeviceSelector;
+    juce::Label secondaryDeviceLabel;
     
-    // Level meters
+    // Level meters: dedicated components that repaint only their dirty
+    // regions, plus a compact per-channel strip fed from the meter bank
+    LevelMeterComponent inputMeter { LevelMeterComponent::Style::input };
+    LevelMeterComponent outputMeter { LevelMeterComponent::Style::output };
+    juce::OwnedArray<LevelMeterComponent> channelMeters;
+    juce::Label inputLevelValueLabel;
+    juce::Label outputLevelValueLabel;
+
+    // Static chrome (title, meter captions) rendered once per resize
+    juce::Image backgroundCache;
+
+    // Change-gated snprintf formatting for everything the 30ms timer writes
+    CachedLabelText statusText;
+    CachedLabelText perfText;
+    CachedLabelText inputLevelText;
+    CachedLabelText outputLevelText;
+
     std::atomic<float> inputLevel {0.0f};
     std::atomic<float> outputLevel {0.0f};
     float smoothedInputLevel = 0.0f;
@@ -69,6 +105,15 @@ private:
     int inputPeakHoldCounter = 0;
     int outputPeakHoldCounter = 0;
     
+    // Latency probe state seen at the last timer tick
+    LatencyProbe::State lastProbeState = LatencyProbe::State::idle;
+
+    // Xrun total already written to the flight recorder
+    juce::uint32 lastXRunCount = 0;
+
+    // Profile version seen at the last timer tick
+    juce::uint32 lastConfigVersion = 0;
+
     // System state
     bool systemOn = false;
     bool testToneActive = false;
@@ -77,18 +122,53 @@ private:
     int currentBufferSize = 512;
     
     // Test tone
-    double testTonePhase = 0.0;
     double testToneFrequency = 440.0;
+
+    // Real-time processing graph - all DSP lives here, not in the callback
+    AudioEngine audioEngine;
+
+    // Lock-free UI -> audio thread parameter exchange
+    ParameterStore parameters;
+
+    // Network control surface for the Python agent system
+    OscBridge oscBridge { audioEngine };
+
+    // Foot-pedal control surface (CC64/CC65/CC11/CC80 per config.yaml)
+    MidiPedalInput midiPedalInput { audioEngine, deviceManager };
+
+    // Scrolling input waveform fed from the engine's history pyramid
+    WaveformComponent waveformView { audioEngine.getWaveformHistory() };
+
+    // Background device enumeration with a cached snapshot
+    DeviceScanner deviceScanner { deviceManager };
+
+    // Optional second capture device on its own callback thread; its
+    // channels are appended to the main buffer ahead of the engine
+    SecondaryInput secondaryInput;
+    juce::AudioBuffer<float> aggregateBuffer;
+    int secondaryChannelOffset = 0;
+
+    // Audio callback cost instrumentation
+    CallbackMonitor callbackMonitor;
     
+    // Persisted settings (device setup + UI state) for fast restarts
+    juce::ApplicationProperties appProperties;
+
+#if PERFORMIA_OPENGL
+    // Optional GPU-composited rendering; the dirty-region logic still applies
+    juce::OpenGLContext openGLContext;
+#endif
+
     // Look and Feel
     juce::LookAndFeel_V4 darkLookAndFeel;
-    
+
     void updateDeviceList();
+    void populateDeviceSelectors();
     void setAudioDevice(const juce::String& deviceName, bool isInput);
     void updateChannelSelector();
     void logMessage(const juce::String& message);
-    void drawLevelMeter (juce::Graphics& g, juce::Rectangle<float> bounds, 
-                        float level, float peakHold, bool isInput);
-    
+    void rebuildChannelMeters();
+    void refreshDeviceInfo();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
 };
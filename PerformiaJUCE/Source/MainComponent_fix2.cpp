@@ -1,3 +0,0 @@
-    // Get the actual number of active input and output channels from device
-    const int numInputChannels = bufferToFill.buffer->getNumChannels();
-    const int numOutputChannels = bufferToFill.buffer->getNumChannels();
\ No newline at end of file
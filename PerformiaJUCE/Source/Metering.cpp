@@ -0,0 +1,61 @@
+#include "Metering.h"
+
+LevelMeterBank::LevelMeterBank()
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        channelPeaks[ch].store (0.0f, std::memory_order_relaxed);
+        channelRMS[ch].store (0.0f, std::memory_order_relaxed);
+        blockPeaks[ch] = 0.0f;
+    }
+}
+
+void LevelMeterBank::prepare (int numChannelsToMeter)
+{
+    numChannels = juce::jmin (numChannelsToMeter, maxChannels);
+
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        channelPeaks[ch].store (0.0f, std::memory_order_relaxed);
+        channelRMS[ch].store (0.0f, std::memory_order_relaxed);
+        blockPeaks[ch] = 0.0f;
+    }
+}
+
+void LevelMeterBank::measureBlock (const juce::AudioBuffer<float>& buffer,
+                                   int startSample, int numSamples)
+{
+    const int channelsToScan = juce::jmin (numChannels, buffer.getNumChannels());
+    const float rmsScale = numSamples > 0 ? 1.0f / (float) numSamples : 0.0f;
+
+    for (int ch = 0; ch < channelsToScan; ++ch)
+    {
+        const float* data = buffer.getReadPointer (ch, startSample);
+
+        // Peak: one vectorized min/max pass instead of per-sample abs/compare
+        auto range = juce::FloatVectorOperations::findMinAndMax (data, numSamples);
+        const float peak = juce::jmax (-range.getStart(), range.getEnd());
+
+        // RMS: four independent accumulators so the loop vectorizes cleanly
+        float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+        int i = 0;
+        for (; i <= numSamples - 4; i += 4)
+        {
+            sum0 += data[i]     * data[i];
+            sum1 += data[i + 1] * data[i + 1];
+            sum2 += data[i + 2] * data[i + 2];
+            sum3 += data[i + 3] * data[i + 3];
+        }
+        for (; i < numSamples; ++i)
+            sum0 += data[i] * data[i];
+
+        const float rms = std::sqrt ((sum0 + sum1 + sum2 + sum3) * rmsScale);
+
+        blockPeaks[ch] = peak;
+        channelPeaks[ch].store (peak, std::memory_order_relaxed);
+        channelRMS[ch].store (rms, std::memory_order_relaxed);
+    }
+
+    for (int ch = channelsToScan; ch < numChannels; ++ch)
+        blockPeaks[ch] = 0.0f;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Vectorized per-channel peak/RMS metering.
+
+    One measureBlock() call per audio callback replaces the old per-sample
+    std::abs scan loops: peaks come from FloatVectorOperations::findMinAndMax
+    (SSE/NEON under the hood) and RMS from a four-accumulator sum-of-squares
+    loop the compiler vectorizes. Results land in a per-channel atomic array
+    that the message thread reads for metering, plus a plain block-local copy
+    the rest of the engine graph can read without atomic traffic.
+*/
+class LevelMeterBank
+{
+public:
+    static constexpr int maxChannels = 64;
+
+    LevelMeterBank();
+
+    void prepare (int numChannelsToMeter);
+
+    /** Audio thread: measures every channel of the block in one pass. */
+    void measureBlock (const juce::AudioBuffer<float>& buffer,
+                       int startSample, int numSamples);
+
+    //==============================================================================
+    // Message-thread readers
+    float getPeak (int channel) const { return channelPeaks[channel].load (std::memory_order_relaxed); }
+    float getRMS (int channel) const  { return channelRMS[channel].load (std::memory_order_relaxed); }
+    int getNumChannels() const        { return numChannels; }
+
+    //==============================================================================
+    // Audio-thread readers - valid for the block just measured
+    float getBlockPeak (int channel) const { return blockPeaks[channel]; }
+
+private:
+    std::atomic<float> channelPeaks[maxChannels];
+    std::atomic<float> channelRMS[maxChannels];
+    float blockPeaks[maxChannels];
+    int numChannels = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeterBank)
+};
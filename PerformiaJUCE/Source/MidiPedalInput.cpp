@@ -0,0 +1,43 @@
+#include "MidiPedalInput.h"
+
+//==============================================================================
+MidiPedalInput::MidiPedalInput (AudioEngine& engineToDrive,
+                                juce::AudioDeviceManager& deviceManagerToUse)
+    : engine (engineToDrive), deviceManager (deviceManagerToUse)
+{
+    // Enable every connected MIDI input and listen on all of them - pedal
+    // boards show up under wildly different names, so we don't filter
+    for (auto& device : juce::MidiInput::getAvailableDevices())
+        deviceManager.setMidiInputDeviceEnabled (device.identifier, true);
+
+    deviceManager.addMidiInputDeviceCallback ({}, this);
+}
+
+MidiPedalInput::~MidiPedalInput()
+{
+    deviceManager.removeMidiInputDeviceCallback ({}, this);
+}
+
+void MidiPedalInput::handleIncomingMidiMessage (juce::MidiInput*,
+                                                const juce::MidiMessage& message)
+{
+    // MIDI callback thread: no allocation, no locks. Anything that isn't a
+    // mapped pedal controller is ignored here rather than queued.
+    if (! message.isController())
+        return;
+
+    const int controller = message.getControllerNumber();
+
+    if (controller != PedalEvent::sustainController
+         && controller != PedalEvent::modeChangeController
+         && controller != PedalEvent::expressionController
+         && controller != PedalEvent::tapTempoController)
+        return;
+
+    PedalEvent event;
+    event.controller = controller;
+    event.value = message.getControllerValue();
+    event.sampleTimestamp = engine.getSamplePosition();
+
+    engine.getPedalEventQueue().push (event);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <juce_audio_devices/juce_audio_devices.h>
+#include "AudioEngine.h"
+
+//==============================================================================
+/**
+    Foot-pedal control surface for the engine.
+
+    Registers as a MIDI input callback on every enabled device, filters for
+    the controller numbers mapped in config/config.yaml (sustain CC64, mode
+    CC65, expression CC11, tap tempo CC80), stamps each one against the
+    engine's sample clock on arrival, and pushes it into the engine's
+    preallocated pedal queue. The engine splits its block at those
+    timestamps, so pedal-to-audio response is sample-accurate instead of
+    taking the ~10ms round trip through the Python mido path.
+*/
+class MidiPedalInput : private juce::MidiInputCallback
+{
+public:
+    explicit MidiPedalInput (AudioEngine& engineToDrive,
+                             juce::AudioDeviceManager& deviceManagerToUse);
+    ~MidiPedalInput() override;
+
+private:
+    void handleIncomingMidiMessage (juce::MidiInput* source,
+                                    const juce::MidiMessage& message) override;
+
+    AudioEngine& engine;
+    juce::AudioDeviceManager& deviceManager;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiPedalInput)
+};
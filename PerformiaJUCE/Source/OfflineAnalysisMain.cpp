@@ -0,0 +1,308 @@
+#include <juce_core/juce_core.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "ChordDetector.h"
+#include "Recorder.h"
+
+//==============================================================================
+/*
+    performia_offline: freewheeling analysis of a recorded session.
+
+    Live, the analysis pipeline is throttled by the soundcard - it can only
+    ever run at 1x. This tool mmaps a recording in the recorder's raw format
+    (see Recorder.h), splits it into one contiguous segment per core, and
+    drives a private ChordDetector over each segment as fast as the memory
+    bus allows, with no device, no callback and no pacing. Each segment is
+    fed a warm-up pre-roll of one FFT window from the preceding segment so
+    its first kept hop sees a fully populated sliding window, and the kept
+    hops are merged back into one ordered timeline. A 30-minute rehearsal
+    analyses in a few seconds:
+
+        performia_offline take.prfm [results.csv] [--threads N]
+
+    The results file carries one row per hop - time, chord, confidence,
+    onset flag, tempo and beat phase - ready for the Python side to load.
+*/
+
+namespace
+{
+
+//==============================================================================
+/** Analyses one contiguous span of frames with its own detector, collecting
+    every kept hop in memory. Implements AnalysisSink so the detector's
+    normal publishing path needs no offline special-casing.
+*/
+class SegmentAnalyser : public juce::Thread,
+                        public AnalysisSink
+{
+public:
+    struct Hop
+    {
+        double timeSeconds;
+        HopResult result;
+    };
+
+    SegmentAnalyser (const float* interleavedFrames, int totalChannels, int channelToAnalyse,
+                     juce::int64 firstFrame, juce::int64 frameCount,
+                     juce::int64 preRollFrameCount, double sampleRateToUse)
+        : juce::Thread ("Offline Analysis"),
+          frames (interleavedFrames),
+          numChannels (totalChannels),
+          channel (channelToAnalyse),
+          startFrame (firstFrame),
+          numFrames (frameCount),
+          preRollFrames (preRollFrameCount),
+          sampleRate (sampleRateToUse)
+    {
+    }
+
+    ~SegmentAnalyser() override
+    {
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        detector.prepare (sampleRate);
+        detector.setPublisher (this);
+
+        // Feed from the pre-roll so the sliding window is warm by the time
+        // the segment proper starts; publishHop drops the warm-up hops.
+        const juce::int64 feedStart = startFrame - preRollFrames;
+        const juce::int64 feedEnd = startFrame + numFrames;
+        float scratch[chunkFrames];
+
+        for (auto frame = feedStart; frame < feedEnd;)
+        {
+            const int count = (int) juce::jmin ((juce::int64) chunkFrames, feedEnd - frame);
+
+            for (int i = 0; i < count; ++i)
+                scratch[i] = frames[(frame + i) * numChannels + channel];
+
+            detector.pushSamples (scratch, count);
+            detector.processPendingHops();
+            frame += count;
+        }
+    }
+
+    void publishHop (const HopResult& result) override
+    {
+        ++hopsAnalysed;
+        const auto hopEndFrame = startFrame - preRollFrames
+                                   + hopsAnalysed * (juce::int64) ChordDetector::hopSize;
+
+        if (hopEndFrame <= startFrame)
+            return;     // Warm-up hop, owned by the preceding segment
+
+        hops.push_back ({ (double) hopEndFrame / sampleRate, result });
+    }
+
+    std::vector<Hop> hops;
+
+private:
+    static constexpr int chunkFrames = 4096;
+
+    ChordDetector detector;
+
+    const float* frames;
+    const int numChannels, channel;
+    const juce::int64 startFrame, numFrames, preRollFrames;
+    const double sampleRate;
+    juce::int64 hopsAnalysed = 0;
+};
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::String inputPath, outputPath;
+    int requestedThreads = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+
+        if (arg == "--threads" && i + 1 < argc)
+            requestedThreads = juce::String (argv[++i]).getIntValue();
+        else if (inputPath.isEmpty())
+            inputPath = arg;
+        else
+            outputPath = arg;
+    }
+
+    if (inputPath.isEmpty())
+    {
+        std::fprintf (stderr, "usage: performia_offline <recording.prfm> [results.csv] [--threads N]\n");
+        return 1;
+    }
+
+    const juce::File inputFile (juce::File::getCurrentWorkingDirectory().getChildFile (inputPath));
+    const juce::File outputFile (outputPath.isNotEmpty()
+                                     ? juce::File::getCurrentWorkingDirectory().getChildFile (outputPath)
+                                     : inputFile.withFileExtension ("csv"));
+
+    //==============================================================================
+    // Header, then mmap the whole take read-only
+    int numChannels = 0;
+    double sampleRate = 0.0;
+
+    {
+        juce::FileInputStream header (inputFile);
+        if (header.failedToOpen())
+        {
+            std::fprintf (stderr, "could not open %s\n", inputPath.toRawUTF8());
+            return 1;
+        }
+
+        if ((juce::uint32) header.readInt() != Recorder::fileMagic
+             || (juce::uint32) header.readInt() != Recorder::fileVersion)
+        {
+            std::fprintf (stderr, "%s is not a Performia recording\n", inputPath.toRawUTF8());
+            return 1;
+        }
+
+        numChannels = header.readInt();
+        header.readInt();
+        sampleRate = header.readDouble();
+    }
+
+    if (numChannels < 1 || sampleRate <= 0.0)
+    {
+        std::fprintf (stderr, "malformed header in %s\n", inputPath.toRawUTF8());
+        return 1;
+    }
+
+    juce::MemoryMappedFile mapping (inputFile, juce::MemoryMappedFile::readOnly);
+    if (mapping.getData() == nullptr)
+    {
+        std::fprintf (stderr, "could not map %s\n", inputPath.toRawUTF8());
+        return 1;
+    }
+
+    const auto* frames = reinterpret_cast<const float*> (
+        static_cast<const char*> (mapping.getData()) + Recorder::headerBytes);
+
+    auto totalFrames = ((juce::int64) mapping.getSize() - Recorder::headerBytes)
+                         / (juce::int64) (numChannels * sizeof (float));
+
+    // The recorder grows the file in 64MB chunks, so a take ends in zero
+    // padding - trim it rather than analysing minutes of silence.
+    while (totalFrames > 0)
+    {
+        bool silent = true;
+        for (int ch = 0; ch < numChannels && silent; ++ch)
+            silent = frames[(totalFrames - 1) * numChannels + ch] == 0.0f;
+
+        if (! silent)
+            break;
+        --totalFrames;
+    }
+
+    if (totalFrames < ChordDetector::fftSize)
+    {
+        std::fprintf (stderr, "%s is too short to analyse\n", inputPath.toRawUTF8());
+        return 1;
+    }
+
+    //==============================================================================
+    // Analyse the loudest channel, matching what the live input stage feeds
+    int channel = 0;
+
+    if (numChannels > 1)
+    {
+        float bestPeak = -1.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float peak = 0.0f;
+            for (juce::int64 frame = 0; frame < totalFrames; ++frame)
+                peak = juce::jmax (peak, std::abs (frames[frame * numChannels + ch]));
+
+            if (peak > bestPeak)
+            {
+                bestPeak = peak;
+                channel = ch;
+            }
+        }
+    }
+
+    const int numThreads = requestedThreads > 0
+                               ? requestedThreads
+                               : juce::jmax (1, juce::SystemStats::getNumCpus() - 1);
+
+    // One contiguous segment per worker, but never so short that the warm-up
+    // pre-roll dominates it
+    const auto numSegments = (int) juce::jlimit ((juce::int64) 1, (juce::int64) numThreads,
+                                                 totalFrames / (juce::int64) (8 * ChordDetector::fftSize));
+
+    const auto startTimeMs = juce::Time::getMillisecondCounterHiRes();
+
+    juce::OwnedArray<SegmentAnalyser> segments;
+
+    for (int i = 0; i < numSegments; ++i)
+    {
+        const auto firstFrame = totalFrames * i / numSegments;
+        const auto frameCount = totalFrames * (i + 1) / numSegments - firstFrame;
+        const auto preRoll = i > 0 ? (juce::int64) ChordDetector::fftSize : 0;
+
+        segments.add (new SegmentAnalyser (frames, numChannels, channel,
+                                           firstFrame, frameCount, preRoll, sampleRate));
+    }
+
+    for (auto* segment : segments)
+        segment->startThread();
+
+    for (auto* segment : segments)
+        segment->waitForThreadToExit (-1);
+
+    const auto elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startTimeMs) * 1.0e-3;
+
+    //==============================================================================
+    // Merge the per-segment timelines into one results file. Each segment's
+    // detector started from "no chord", so chord-change flags are recomputed
+    // across the stitched stream.
+    std::FILE* out = std::fopen (outputFile.getFullPathName().toRawUTF8(), "w");
+    if (out == nullptr)
+    {
+        std::fprintf (stderr, "could not write %s\n", outputFile.getFullPathName().toRawUTF8());
+        return 1;
+    }
+
+    std::fprintf (out, "time_s,chord,chord_name,confidence,onset,tempo_bpm,beat_phase\n");
+
+    juce::int64 totalHops = 0, chordChanges = 0, onsets = 0;
+    int lastChord = -1;
+
+    for (const auto* segment : segments)
+    {
+        for (const auto& hop : segment->hops)
+        {
+            const bool chordChanged = hop.result.chord != lastChord;
+            lastChord = hop.result.chord;
+
+            std::fprintf (out, "%.6f,%d,%s,%.4f,%d,%.2f,%.4f\n",
+                          hop.timeSeconds, hop.result.chord,
+                          ChordDetector::getChordName (hop.result.chord),
+                          hop.result.confidence, hop.result.onset ? 1 : 0,
+                          hop.result.tempoBpm, hop.result.beatPhase);
+
+            ++totalHops;
+            chordChanges += chordChanged && hop.result.chord >= 0 ? 1 : 0;
+            onsets += hop.result.onset ? 1 : 0;
+        }
+    }
+
+    std::fclose (out);
+
+    const double durationSeconds = (double) totalFrames / sampleRate;
+
+    std::printf ("%.1fs of audio (%d channel%s, analysed channel %d) in %.2fs - %.0fx realtime\n",
+                 durationSeconds, numChannels, numChannels == 1 ? "" : "s",
+                 channel + 1, elapsedSeconds, durationSeconds / juce::jmax (1.0e-6, elapsedSeconds));
+    std::printf ("%lld hops, %lld chord changes, %lld onsets -> %s\n",
+                 (long long) totalHops, (long long) chordChanges, (long long) onsets,
+                 outputFile.getFullPathName().toRawUTF8());
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "OscBridge.h"
+
+OscBridge::OscBridge (AudioEngine& engineToDrive)
+    : engine (engineToDrive)
+{
+}
+
+OscBridge::~OscBridge()
+{
+    disconnect();
+}
+
+bool OscBridge::connect (int portNumber)
+{
+    disconnect();
+
+    if (! receiver.connect (portNumber))
+    {
+        DBG ("OscBridge: could not bind UDP port " << portNumber);
+        return false;
+    }
+
+    receiver.addListener (this);
+    connected = true;
+
+    DBG ("OscBridge: listening on port " << portNumber);
+    return true;
+}
+
+void OscBridge::disconnect()
+{
+    if (! connected)
+        return;
+
+    receiver.removeListener (this);
+    receiver.disconnect();
+    connected = false;
+}
+
+float OscBridge::argumentAsFloat (const juce::OSCArgument& argument)
+{
+    if (argument.isFloat32())  return argument.getFloat32();
+    if (argument.isInt32())    return (float) argument.getInt32();
+    return 0.0f;
+}
+
+void OscBridge::oscMessageReceived (const juce::OSCMessage& message)
+{
+    // Runs on the OSC receiver thread (RealtimeCallback) - build a fixed-size
+    // event, stamp it with the engine's sample clock and push. No allocation.
+    const auto address = message.getAddressPattern();
+
+    OscEvent event;
+    event.sampleTimestamp = engine.getSamplePosition();
+
+    if (address.matches ("/performia/note"))
+    {
+        if (message.size() < 1)
+            return;
+
+        event.type = OscEvent::Type::note;
+        event.value1 = argumentAsFloat (message[0]);
+        event.value2 = message.size() > 1 ? argumentAsFloat (message[1]) : 1.0f;
+
+        // Optional third argument: agent voice type
+        // (0 drums, 1 bass, 2 melody, 3 harmony)
+        event.value3 = message.size() > 2 ? argumentAsFloat (message[2]) : 2.0f;
+    }
+    else if (address.matches ("/performia/gain"))
+    {
+        if (message.size() < 1)
+            return;
+
+        event.type = OscEvent::Type::gain;
+        event.value1 = argumentAsFloat (message[0]);
+    }
+    else if (address.matches ("/performia/channel"))
+    {
+        if (message.size() < 1)
+            return;
+
+        event.type = OscEvent::Type::channel;
+        event.value1 = argumentAsFloat (message[0]);
+    }
+    else if (address.matches ("/performia/route"))
+    {
+        if (message.size() < 3)
+            return;
+
+        event.type = OscEvent::Type::route;
+        event.value1 = argumentAsFloat (message[0]);
+        event.value2 = argumentAsFloat (message[1]);
+        event.value3 = argumentAsFloat (message[2]);
+    }
+    else
+    {
+        return;
+    }
+
+    engine.getOscEventQueue().push (event);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <juce_osc/juce_osc.h>
+#include "AudioEngine.h"
+
+//==============================================================================
+/**
+    Network control surface for the engine.
+
+    Receives /performia/note, /performia/gain and /performia/channel messages
+    from the Python agent system (the counterpart of src/engine/supercollider.py)
+    on juce_osc's own receiver thread, stamps each one against the engine's
+    sample clock, and pushes it into the engine's preallocated SPSC queue.
+    Nothing here ever touches the message thread or the audio thread directly.
+*/
+class OscBridge : private juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>
+{
+public:
+    static constexpr int defaultPort = 9001;
+
+    explicit OscBridge (AudioEngine& engineToDrive);
+    ~OscBridge() override;
+
+    /** Starts listening. Returns false if the port could not be bound. */
+    bool connect (int portNumber = defaultPort);
+    void disconnect();
+
+    bool isConnected() const { return connected; }
+
+private:
+    void oscMessageReceived (const juce::OSCMessage& message) override;
+
+    static float argumentAsFloat (const juce::OSCArgument& argument);
+
+    AudioEngine& engine;
+    juce::OSCReceiver receiver;
+    bool connected = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OscBridge)
+};
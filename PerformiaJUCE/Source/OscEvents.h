@@ -0,0 +1,67 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+    Fixed-size control event handed from the OSC network thread to the audio
+    engine. Timestamps are in samples on the engine's own clock so events can
+    be applied sample-accurately inside the block they land in.
+*/
+struct OscEvent
+{
+    enum class Type { note, gain, channel, route };
+
+    Type type = Type::note;
+    float value1 = 0.0f;   // note number / gain / channel index / route input
+    float value2 = 0.0f;   // velocity for note events / route output
+    float value3 = 0.0f;   // route gain / voice type for note events
+    juce::int64 sampleTimestamp = 0;
+};
+
+//==============================================================================
+/**
+    Preallocated single-producer/single-consumer queue of OscEvents.
+
+    The OSC receiver thread is the only producer and the audio callback the
+    only consumer, so juce::AbstractFifo gives us wait-free hand-off with no
+    allocation after construction. Events are dropped (never blocked on) if
+    the queue fills.
+*/
+class OscEventQueue
+{
+public:
+    static constexpr int capacity = 1024;
+
+    bool push (const OscEvent& event)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+        if (size1 <= 0)
+            return false;
+
+        buffer[start1] = event;
+        fifo.finishedWrite (1);
+        return true;
+    }
+
+    bool pop (OscEvent& eventOut)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (1, start1, size1, start2, size2);
+
+        if (size1 <= 0)
+            return false;
+
+        eventOut = buffer[start1];
+        fifo.finishedRead (1);
+        return true;
+    }
+
+private:
+    juce::AbstractFifo fifo { capacity };
+    OscEvent buffer[capacity];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OscEventQueue)
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "AudioEngine.h"
+
+//==============================================================================
+/**
+    Lock-free parameter bridge between the message thread and the audio callback.
+
+    This generalizes the std::atomic<float> level-meter pattern already used in
+    MainComponent: the UI publishes each control value with a relaxed atomic
+    store whenever it changes, and the callback assembles a complete EngineState
+    snapshot once per block with wait-free loads. No JUCE component is ever
+    touched from the real-time thread, so a busy repaint can no longer stall
+    the callback at small buffer sizes.
+*/
+class ParameterStore
+{
+public:
+    //==============================================================================
+    // Message-thread writers
+    void setSelectedInputChannel (int channel)   { selectedInputChannel.store (channel, std::memory_order_relaxed); }
+    void setOutputGain (float gain)              { outputGain.store (gain, std::memory_order_relaxed); }
+    void setTestToneFrequency (double frequency) { testToneFrequency.store (frequency, std::memory_order_relaxed); }
+    void setTestToneActive (bool active)         { testToneActive.store (active, std::memory_order_relaxed); }
+    void setInputMonitoring (bool active)        { inputMonitoring.store (active, std::memory_order_relaxed); }
+
+    //==============================================================================
+    /** Audio-thread reader - builds one coherent snapshot per block. */
+    EngineState read() const
+    {
+        EngineState state;
+        state.selectedInputChannel = selectedInputChannel.load (std::memory_order_relaxed);
+        state.outputGain = outputGain.load (std::memory_order_relaxed);
+        state.testToneFrequency = testToneFrequency.load (std::memory_order_relaxed);
+        state.testToneActive = testToneActive.load (std::memory_order_relaxed);
+        state.inputMonitoring = inputMonitoring.load (std::memory_order_relaxed);
+        return state;
+    }
+
+private:
+    std::atomic<int> selectedInputChannel { 0 };
+    std::atomic<float> outputGain { 0.75f };      // slider default 75 / 100
+    std::atomic<double> testToneFrequency { 440.0 };
+    std::atomic<bool> testToneActive { false };
+    std::atomic<bool> inputMonitoring { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterStore)
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+    One MIDI pedal controller change, handed from the MIDI input thread to
+    the audio engine. Controller numbers follow the pedal_mappings section of
+    config/config.yaml; timestamps are samples on the engine's clock so the
+    engine can split the block and apply the change on the exact sample.
+*/
+struct PedalEvent
+{
+    // CC numbers from config/config.yaml pedal_mappings
+    static constexpr int sustainController = 64;      // Main listen trigger
+    static constexpr int modeChangeController = 65;   // Cycle listening modes
+    static constexpr int expressionController = 11;   // Continuous control
+    static constexpr int tapTempoController = 80;     // Manual tempo setting
+
+    int controller = 0;
+    int value = 0;                                    // Raw 0-127 CC value
+    juce::int64 sampleTimestamp = 0;
+};
+
+//==============================================================================
+/**
+    Preallocated single-producer/single-consumer queue of PedalEvents.
+
+    Same hand-off pattern as OscEventQueue: the MIDI callback thread is the
+    only producer and the audio callback the only consumer, so the FIFO is
+    wait-free and allocation-free. Pedal events are sparse; drops only
+    happen if someone sends a controller sweep faster than a block.
+*/
+class PedalEventQueue
+{
+public:
+    static constexpr int capacity = 256;
+
+    bool push (const PedalEvent& event)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+        if (size1 <= 0)
+            return false;
+
+        buffer[start1] = event;
+        fifo.finishedWrite (1);
+        return true;
+    }
+
+    bool pop (PedalEvent& eventOut)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (1, start1, size1, start2, size2);
+
+        if (size1 <= 0)
+            return false;
+
+        eventOut = buffer[start1];
+        fifo.finishedRead (1);
+        return true;
+    }
+
+private:
+    juce::AbstractFifo fifo { capacity };
+    PedalEvent buffer[capacity];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PedalEventQueue)
+};
@@ -0,0 +1,189 @@
+#include "Recorder.h"
+
+Recorder::Recorder()
+    : juce::Thread ("Recorder Writer")
+{
+    ring.allocate (ringSize, true);
+}
+
+Recorder::~Recorder()
+{
+    stopRecording();
+    stopThread (5000);
+}
+
+void Recorder::prepare (int numChannelsToRecord, double sampleRateToUse)
+{
+    stopRecording();
+    numChannels = numChannelsToRecord;
+    sampleRate = sampleRateToUse;
+}
+
+bool Recorder::startRecording (const juce::File& file)
+{
+    stopRecording();
+
+    const juce::ScopedLock lock (fileLock);
+
+    file.deleteFile();
+
+    // Write the header, then size the file to the first chunk so the writer
+    // can map it. The file stays chunk-aligned; trailing zeros past the last
+    // sample are truncated on stop.
+    {
+        juce::FileOutputStream header (file);
+        if (header.failedToOpen())
+            return false;
+
+        header.writeInt ((int) fileMagic);
+        header.writeInt ((int) fileVersion);
+        header.writeInt (numChannels);
+        header.writeInt (0);
+        header.writeDouble (sampleRate);
+        header.writeInt64 (0);
+
+        header.setPosition (headerBytes + chunkBytes - 1);
+        header.writeByte (0);
+    }
+
+    outputFile = file;
+    chunkStart = headerBytes;
+    writeOffset = headerBytes;
+    mappedChunk = std::make_unique<juce::MemoryMappedFile> (
+        file, juce::Range<juce::int64> (chunkStart, chunkStart + chunkBytes),
+        juce::MemoryMappedFile::readWrite);
+
+    if (mappedChunk->getData() == nullptr)
+    {
+        mappedChunk = nullptr;
+        return false;
+    }
+
+    ringFifo.reset();
+    droppedBlocks.store (0, std::memory_order_relaxed);
+    recording.store (true, std::memory_order_release);
+
+    startThread();
+    return true;
+}
+
+void Recorder::stopRecording()
+{
+    recording.store (false, std::memory_order_release);
+    stopThread (5000);
+
+    const juce::ScopedLock lock (fileLock);
+    closeFile();
+}
+
+void Recorder::closeFile()
+{
+    if (mappedChunk == nullptr)
+        return;
+
+    mappedChunk = nullptr;
+
+    // Trim the chunk-aligned file back to the data actually written
+    juce::FileOutputStream trimmer (outputFile);
+    if (! trimmer.failedToOpen())
+        trimmer.setPosition (writeOffset), trimmer.truncate();
+}
+
+void Recorder::pushBlock (const juce::AudioBuffer<float>& buffer,
+                          int startSample, int numSamples)
+{
+    if (! recording.load (std::memory_order_acquire))
+        return;
+
+    const int channels = juce::jmin (numChannels, buffer.getNumChannels());
+    const int framesNeeded = numSamples * channels;
+
+    int start1, size1, start2, size2;
+    ringFifo.prepareToWrite (framesNeeded, start1, size1, start2, size2);
+
+    if (size1 + size2 < framesNeeded)
+    {
+        droppedBlocks.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Interleave frames straight into the ring
+    int written = 0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            const float sample = buffer.getSample (ch, startSample + i);
+            const int index = written < size1 ? start1 + written
+                                              : start2 + (written - size1);
+            ring[index] = sample;
+            ++written;
+        }
+    }
+
+    ringFifo.finishedWrite (framesNeeded);
+    notify();
+}
+
+bool Recorder::mapNextChunk()
+{
+    chunkStart += chunkBytes;
+
+    // Grow the file by one chunk (sparse on APFS/ext4, so this is cheap)
+    {
+        juce::FileOutputStream grower (outputFile);
+        if (grower.failedToOpen())
+            return false;
+
+        grower.setPosition (chunkStart + chunkBytes - 1);
+        grower.writeByte (0);
+    }
+
+    mappedChunk = std::make_unique<juce::MemoryMappedFile> (
+        outputFile, juce::Range<juce::int64> (chunkStart, chunkStart + chunkBytes),
+        juce::MemoryMappedFile::readWrite);
+
+    return mappedChunk->getData() != nullptr;
+}
+
+void Recorder::run()
+{
+    while (! threadShouldExit())
+    {
+        const int ready = ringFifo.getNumReady();
+
+        if (ready == 0)
+        {
+            wait (50);
+            continue;
+        }
+
+        const juce::ScopedLock lock (fileLock);
+
+        if (mappedChunk == nullptr)
+            return;
+
+        // Clamp the copy to what fits in the current mapping
+        const juce::int64 chunkRemaining = (chunkStart + chunkBytes - writeOffset)
+                                            / (juce::int64) sizeof (float);
+        const int toCopy = (int) juce::jmin ((juce::int64) ready, chunkRemaining);
+
+        int start1, size1, start2, size2;
+        ringFifo.prepareToRead (toCopy, start1, size1, start2, size2);
+
+        auto* dest = (float*) ((char*) mappedChunk->getData()
+                               + (writeOffset - chunkStart));
+
+        if (size1 > 0)
+            std::memcpy (dest, ring + start1, (size_t) size1 * sizeof (float));
+        if (size2 > 0)
+            std::memcpy (dest + size1, ring + start2, (size_t) size2 * sizeof (float));
+
+        ringFifo.finishedRead (size1 + size2);
+        writeOffset += (juce::int64) (size1 + size2) * (juce::int64) sizeof (float);
+
+        if (writeOffset >= chunkStart + chunkBytes)
+            if (! mapNextChunk())
+                return;
+    }
+}
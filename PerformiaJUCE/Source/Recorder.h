@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Multi-channel capture that never allocates or syscalls on the audio thread.
+
+    The callback interleaves each input block into a large preallocated
+    lock-free ring; a writer thread drains the ring into a memory-mapped file
+    that is grown and remapped in 64MB chunks. The format is deliberately
+    dumb - a small header followed by interleaved raw 32-bit floats - so the
+    Python side (and the offline analysis tools) can mmap it straight back.
+
+    Header layout (little-endian, 32 bytes):
+        magic 'PRFM' | version u32 | numChannels u32 | sampleRate f64 | reserved
+*/
+class Recorder : private juce::Thread
+{
+public:
+    static constexpr juce::uint32 fileMagic = 0x4d465250;   // 'PRFM'
+    static constexpr juce::uint32 fileVersion = 1;
+    static constexpr juce::int64 headerBytes = 32;
+    static constexpr juce::int64 chunkBytes = 64 * 1024 * 1024;
+
+    Recorder();
+    ~Recorder() override;
+
+    void prepare (int numChannelsToRecord, double sampleRateToUse);
+
+    /** Message thread: starts capturing into the given file. */
+    bool startRecording (const juce::File& file);
+    void stopRecording();
+
+    bool isRecording() const { return recording.load (std::memory_order_relaxed); }
+
+    /** Audio thread: interleaves one block into the ring. Wait-free; if the
+        writer falls behind the block is dropped and the overrun counted.
+    */
+    void pushBlock (const juce::AudioBuffer<float>& buffer,
+                    int startSample, int numSamples);
+
+    juce::uint32 getDroppedBlockCount() const { return droppedBlocks.load (std::memory_order_relaxed); }
+
+private:
+    void run() override;
+    bool mapNextChunk();
+    void closeFile();
+
+    int numChannels = 0;
+    double sampleRate = 48000.0;
+
+    // Callback -> writer ring of interleaved samples (~16MB)
+    static constexpr int ringSize = 1 << 22;
+    juce::HeapBlock<float> ring;
+    juce::AbstractFifo ringFifo { ringSize };
+    std::atomic<juce::uint32> droppedBlocks { 0 };
+
+    std::atomic<bool> recording { false };
+
+    juce::File outputFile;
+    std::unique_ptr<juce::MemoryMappedFile> mappedChunk;
+    juce::int64 chunkStart = 0;      // File offset of the current mapping
+    juce::int64 writeOffset = 0;     // Absolute file offset of the next write
+    juce::CriticalSection fileLock;  // Guards start/stop against the writer thread
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Recorder)
+};
@@ -0,0 +1,74 @@
+#include "RoutingMatrix.h"
+
+RoutingMatrix::RoutingMatrix()
+{
+    for (auto& gain : routeGains)
+        gain.store (0.0f, std::memory_order_relaxed);
+}
+
+void RoutingMatrix::prepare (int numInputsToUse, int numOutputsToUse, int maxBlockSize)
+{
+    numInputs = juce::jmin (numInputsToUse, maxInputs);
+    numOutputs = juce::jmin (numOutputsToUse, maxOutputs);
+    scratch.setSize (numOutputs, maxBlockSize);
+}
+
+void RoutingMatrix::setRouteGain (int input, int output, float gain)
+{
+    if (input < 0 || input >= maxInputs || output < 0 || output >= maxOutputs)
+        return;
+
+    auto& route = routeGains[input * maxOutputs + output];
+    const float previous = route.exchange (gain, std::memory_order_relaxed);
+
+    if (previous == 0.0f && gain != 0.0f)
+        activeRoutes.fetch_add (1, std::memory_order_relaxed);
+    else if (previous != 0.0f && gain == 0.0f)
+        activeRoutes.fetch_sub (1, std::memory_order_relaxed);
+}
+
+float RoutingMatrix::getRouteGain (int input, int output) const
+{
+    if (input < 0 || input >= maxInputs || output < 0 || output >= maxOutputs)
+        return 0.0f;
+
+    return routeGains[input * maxOutputs + output].load (std::memory_order_relaxed);
+}
+
+void RoutingMatrix::clearAllRoutes()
+{
+    for (auto& gain : routeGains)
+        gain.store (0.0f, std::memory_order_relaxed);
+
+    activeRoutes.store (0, std::memory_order_relaxed);
+}
+
+void RoutingMatrix::apply (juce::AudioBuffer<float>& buffer, int startSample,
+                           int numSamples, float gainStart, float gainEnd)
+{
+    const int inputs = juce::jmin (numInputs, buffer.getNumChannels());
+    const int outputs = juce::jmin (numOutputs, buffer.getNumChannels());
+
+    // Mix into scratch first: inputs and outputs alias the same buffer
+    for (int out = 0; out < outputs; ++out)
+    {
+        auto* dest = scratch.getWritePointer (out);
+        juce::FloatVectorOperations::clear (dest, numSamples);
+
+        for (int in = 0; in < inputs; ++in)
+        {
+            const float gain = routeGains[in * maxOutputs + out].load (std::memory_order_relaxed);
+
+            if (gain != 0.0f)
+                juce::FloatVectorOperations::addWithMultiply (
+                    dest, buffer.getReadPointer (in, startSample), gain, numSamples);
+        }
+    }
+
+    for (int out = 0; out < outputs; ++out)
+    {
+        juce::FloatVectorOperations::copy (buffer.getWritePointer (out, startSample),
+                                           scratch.getReadPointer (out), numSamples);
+        buffer.applyGainRamp (out, startSample, numSamples, gainStart, gainEnd);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    N-in x M-out monitoring matrix with per-route gain.
+
+    Route gains live in a flat, cache-friendly array of atomics: the message
+    thread and OSC handlers write individual routes, the audio thread reads
+    them wait-free. apply() renders all active routes into a preallocated
+    scratch buffer with vectorized add-with-multiply, then copies the result
+    over the outputs - so guitarist-in-both-wedges plus agents-in-mains style
+    routing costs a handful of block operations and stays at one buffer of
+    latency.
+*/
+class RoutingMatrix
+{
+public:
+    static constexpr int maxInputs = 64;
+    static constexpr int maxOutputs = 32;
+
+    RoutingMatrix();
+
+    void prepare (int numInputsToUse, int numOutputsToUse, int maxBlockSize);
+
+    //==============================================================================
+    // Message thread / OSC writers
+    void setRouteGain (int input, int output, float gain);
+    float getRouteGain (int input, int output) const;
+    void clearAllRoutes();
+
+    /** Number of routes with non-zero gain; zero means "no custom routing". */
+    int getNumActiveRoutes() const { return activeRoutes.load (std::memory_order_relaxed); }
+
+    //==============================================================================
+    /** Audio thread: mixes every active route into the outputs in place,
+        scaling the result by the given gain ramp.
+    */
+    void apply (juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                float gainStart, float gainEnd);
+
+private:
+    std::atomic<float> routeGains[maxInputs * maxOutputs];
+    std::atomic<int> activeRoutes { 0 };
+
+    juce::AudioBuffer<float> scratch;
+    int numInputs = 0;
+    int numOutputs = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RoutingMatrix)
+};
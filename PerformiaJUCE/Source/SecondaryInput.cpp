@@ -0,0 +1,175 @@
+#include "SecondaryInput.h"
+
+//==============================================================================
+SecondaryInput::~SecondaryInput()
+{
+    close();
+}
+
+bool SecondaryInput::open (const juce::String& deviceName)
+{
+    close();
+
+    auto error = secondaryManager.initialise (maxChannels, 0, nullptr, false, deviceName);
+    if (error.isNotEmpty())
+    {
+        DBG ("Secondary device open failed: " << error);
+        return false;
+    }
+
+    auto* device = secondaryManager.getCurrentAudioDevice();
+    if (device == nullptr || device->getName() != deviceName)
+    {
+        secondaryManager.closeAudioDevice();
+        return false;
+    }
+
+    ring.setSize (maxChannels, ringSize);
+    ring.clear();
+    framesWritten.store (0, std::memory_order_relaxed);
+    readPosition = 0.0;
+    ratioTrim = 0.0;
+
+    secondaryManager.addAudioCallback (this);
+
+    // addAudioCallback has already delivered audioDeviceAboutToStart, so
+    // secondaryRate is current. The ratio and fill target must be set here,
+    // before the open flag goes out: the main audio thread may pull the
+    // very next block, and these are plain doubles it reads unguarded.
+    baseRatio = secondaryRate.load (std::memory_order_relaxed) / mainRate;
+    targetFill = (double) mainBlockSize * baseRatio;
+
+    // Release publish: the main audio thread's acquire in isOpen() then
+    // sees the cleared ring, reset positions and resampler setup above
+    deviceOpen.store (true, std::memory_order_release);
+    return true;
+}
+
+void SecondaryInput::close()
+{
+    if (! deviceOpen.load (std::memory_order_relaxed))
+        return;
+
+    deviceOpen.store (false, std::memory_order_release);
+    secondaryManager.removeAudioCallback (this);
+    secondaryManager.closeAudioDevice();
+    numChannels.store (0, std::memory_order_relaxed);
+}
+
+juce::String SecondaryInput::getDeviceName() const
+{
+    if (auto* device = secondaryManager.getCurrentAudioDevice())
+        return device->getName();
+
+    return {};
+}
+
+void SecondaryInput::prepareOutput (double mainSampleRate, int mainBlockSizeToUse)
+{
+    mainRate = mainSampleRate;
+    mainBlockSize = mainBlockSizeToUse;
+    baseRatio = secondaryRate.load (std::memory_order_relaxed) / mainRate;
+
+    // One main block of fill is the latency budget; the trim loop below
+    // steers the ring towards it
+    targetFill = (double) mainBlockSize * baseRatio;
+}
+
+//==============================================================================
+void SecondaryInput::audioDeviceAboutToStart (juce::AudioIODevice* device)
+{
+    numChannels.store (juce::jmin (device->getActiveInputChannels().countNumberOfSetBits(),
+                                   (int) maxChannels),
+                       std::memory_order_relaxed);
+    secondaryRate.store (device->getCurrentSampleRate(), std::memory_order_relaxed);
+}
+
+void SecondaryInput::audioDeviceStopped()
+{
+}
+
+void SecondaryInput::audioDeviceIOCallbackWithContext (const float* const* inputChannelData,
+                                                       int numInputChannels,
+                                                       float* const*, int, int numSamples,
+                                                       const juce::AudioIODeviceCallbackContext&)
+{
+    // Secondary driver thread: one wrapped copy per channel into the ring,
+    // then a release publish of the new write position
+    const auto writeStart = framesWritten.load (std::memory_order_relaxed);
+
+    for (int channel = 0; channel < numInputChannels && channel < maxChannels; ++channel)
+    {
+        if (inputChannelData[channel] == nullptr)
+            continue;
+
+        auto writeIndex = (int) (writeStart & (ringSize - 1));
+        const int firstPart = juce::jmin (numSamples, ringSize - writeIndex);
+
+        juce::FloatVectorOperations::copy (ring.getWritePointer (channel, writeIndex),
+                                           inputChannelData[channel], firstPart);
+        if (firstPart < numSamples)
+            juce::FloatVectorOperations::copy (ring.getWritePointer (channel, 0),
+                                               inputChannelData[channel] + firstPart,
+                                               numSamples - firstPart);
+    }
+
+    framesWritten.store (writeStart + numSamples, std::memory_order_release);
+}
+
+//==============================================================================
+void SecondaryInput::pullBlock (juce::AudioBuffer<float>& dest, int destChannelOffset,
+                                int startSample, int numSamples)
+{
+    const int channelsAvailable = numChannels.load (std::memory_order_relaxed);
+
+    if (! deviceOpen.load (std::memory_order_acquire) || channelsAvailable == 0)
+        return;
+
+    const auto written = framesWritten.load (std::memory_order_acquire);
+    const double fill = (double) written - readPosition;
+
+    // Nothing buffered yet (device still starting): resync to the target
+    // fill rather than chasing from zero
+    if (fill < 1.0)
+    {
+        readPosition = (double) written - targetFill;
+        return;
+    }
+
+    // Clock-skew trim: a gentle proportional correction on the fill error,
+    // bounded to +/-1% so a start-up transient can't warp pitch audibly
+    const double fillError = fill - targetFill;
+    ratioTrim = juce::jlimit (-0.01, 0.01, ratioTrim + 1.0e-6 * fillError);
+    const double step = baseRatio + ratioTrim;
+
+    const int channelsToWrite = juce::jmin (channelsAvailable,
+                                            dest.getNumChannels() - destChannelOffset);
+
+    for (int channel = 0; channel < channelsToWrite; ++channel)
+    {
+        auto* out = dest.getWritePointer (destChannelOffset + channel, startSample);
+        const auto* in = ring.getReadPointer (channel);
+        double position = readPosition;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto frame = (juce::int64) position;
+            const float fraction = (float) (position - (double) frame);
+
+            if (frame + 1 >= written)
+            {
+                out[i] = 0.0f;   // Underrun: the trim loop will catch up
+            }
+            else
+            {
+                const float a = in[(int) (frame & (ringSize - 1))];
+                const float b = in[(int) ((frame + 1) & (ringSize - 1))];
+                out[i] = a + fraction * (b - a);
+            }
+
+            position += step;
+        }
+    }
+
+    readPosition += step * numSamples;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_audio_devices/juce_audio_devices.h>
+
+//==============================================================================
+/**
+    A second capture device aggregated into the main callback.
+
+    The secondary interface (e.g. a 2-channel vocal interface next to the
+    Quantum 2626) is opened on its own AudioDeviceManager and delivers blocks
+    on its own driver thread. Those blocks land in a preallocated lock-free
+    ring; the main audio callback pulls them back out through a fractional-
+    delay linear-interpolation resampler whose rate is continuously trimmed
+    by a clock-skew estimate, so the two device clocks can drift without the
+    ring ever running dry or overflowing. Steady-state added latency is the
+    ring's target fill of one main-device block.
+*/
+class SecondaryInput : private juce::AudioIODeviceCallback
+{
+public:
+    static constexpr int maxChannels = 8;
+
+    SecondaryInput() = default;
+    ~SecondaryInput() override;
+
+    /** Opens the named input device on its own manager. Message thread. */
+    bool open (const juce::String& deviceName);
+    void close();
+
+    bool isOpen() const { return deviceOpen.load (std::memory_order_acquire); }
+    int getNumChannels() const { return numChannels.load (std::memory_order_relaxed); }
+    juce::String getDeviceName() const;
+
+    /** Called from the main prepareToPlay - before the main callback runs,
+        so the plain resampler fields are safe to write - to tell the
+        resampler the clock it has to match and the fill target (one main
+        block). open() recomputes the same fields itself, before publishing
+        deviceOpen, so it needs no follow-up call while audio is live.
+    */
+    void prepareOutput (double mainSampleRate, int mainBlockSizeToUse);
+
+    /** Main audio thread: resamples one block out of the ring into the
+        destination channels. Writes silence on underrun.
+    */
+    void pullBlock (juce::AudioBuffer<float>& dest, int destChannelOffset,
+                    int startSample, int numSamples);
+
+private:
+    void audioDeviceIOCallbackWithContext (const float* const* inputChannelData,
+                                           int numInputChannels,
+                                           float* const* outputChannelData,
+                                           int numOutputChannels, int numSamples,
+                                           const juce::AudioIODeviceCallbackContext& context) override;
+    void audioDeviceAboutToStart (juce::AudioIODevice* device) override;
+    void audioDeviceStopped() override;
+
+    static constexpr int ringSize = 1 << 15;   // Per-channel frames, power of two
+
+    juce::AudioDeviceManager secondaryManager;
+    juce::AudioBuffer<float> ring;
+
+    // Writer (secondary driver thread) / reader (main audio thread) state
+    std::atomic<juce::int64> framesWritten { 0 };
+    double readPosition = 0.0;
+
+    // Clock-skew compensation: base ratio from the nominal rates, trimmed
+    // every block by a proportional term on the ring-fill error
+    double baseRatio = 1.0;
+    double ratioTrim = 0.0;
+    double targetFill = 0.0;
+
+    double mainRate = 48000.0;
+    int mainBlockSize = 512;
+    std::atomic<double> secondaryRate { 48000.0 };
+
+    // Written by the secondary driver thread (about-to-start) and the
+    // message thread (open/close), read by the main audio thread every
+    // block - same acquire/release discipline as framesWritten above
+    std::atomic<int> numChannels { 0 };
+    std::atomic<bool> deviceOpen { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SecondaryInput)
+};
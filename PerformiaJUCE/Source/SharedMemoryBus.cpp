@@ -0,0 +1,125 @@
+#include "SharedMemoryBus.h"
+
+#if ! JUCE_WINDOWS
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <unistd.h>
+#endif
+
+//==============================================================================
+SharedMemoryBus::~SharedMemoryBus()
+{
+    close();
+}
+
+bool SharedMemoryBus::create (int numChannelsToPublish, double sampleRateToUse)
+{
+#if ! JUCE_WINDOWS
+    close();
+
+    numChannels = juce::jmin (numChannelsToPublish, maxChannels);
+    mappingSize = sizeof (BusHeader) + sizeof (BusSlot) * (size_t) numSlots;
+
+    // Unlink any stale segment from a previous run so the sizes always match
+    ::shm_unlink (segmentName);
+
+    shmFd = ::shm_open (segmentName, O_CREAT | O_RDWR, 0666);
+    if (shmFd < 0)
+        return false;
+
+    if (::ftruncate (shmFd, (off_t) mappingSize) != 0)
+    {
+        close();
+        return false;
+    }
+
+    mapping = ::mmap (nullptr, mappingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, shmFd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        close();
+        return false;
+    }
+
+    slots = reinterpret_cast<BusSlot*> (static_cast<char*> (mapping) + sizeof (BusHeader));
+    for (int i = 0; i < numSlots; ++i)
+    {
+        slots[i].sequence.store (0, std::memory_order_relaxed);
+        slots[i].numSamples = 0;
+    }
+
+    // The header goes live last: readers treat magic + version as the ready flag
+    auto* newHeader = reinterpret_cast<BusHeader*> (mapping);
+    newHeader->numChannels = (juce::uint32) numChannels;
+    newHeader->slotCount = (juce::uint32) numSlots;
+    newHeader->slotSamples = (juce::uint32) maxSlotSamples;
+    newHeader->reserved = 0;
+    newHeader->sampleRate = sampleRateToUse;
+    newHeader->sequence.store (0, std::memory_order_relaxed);
+    newHeader->version = busVersion;
+    newHeader->magic = busMagic;
+
+    nextSequence = 1;
+    header = newHeader;
+    return true;
+#else
+    juce::ignoreUnused (numChannelsToPublish, sampleRateToUse);
+    return false;
+#endif
+}
+
+void SharedMemoryBus::close()
+{
+#if ! JUCE_WINDOWS
+    header = nullptr;
+    slots = nullptr;
+
+    if (mapping != nullptr)
+    {
+        ::munmap (mapping, mappingSize);
+        mapping = nullptr;
+    }
+
+    if (shmFd >= 0)
+    {
+        ::close (shmFd);
+        ::shm_unlink (segmentName);
+        shmFd = -1;
+    }
+#endif
+}
+
+void SharedMemoryBus::publishBlock (const float* activeChannelAudio, int numSamples,
+                                    juce::int64 samplePosition, const LevelMeterBank& meters,
+                                    int chord, float chordConfidence,
+                                    float tempoBpm, float beatPhase)
+{
+    if (header == nullptr)
+        return;
+
+    auto& slot = slots[nextSequence % (juce::uint64) numSlots];
+
+    // Mark the slot as in-flight so a reader caught mid-copy can detect the
+    // torn read by re-checking the slot sequence afterwards
+    slot.sequence.store (0, std::memory_order_release);
+
+    slot.samplePosition = samplePosition;
+    slot.numSamples = juce::jmin (numSamples, (int) maxSlotSamples);
+    slot.chord = chord;
+    slot.chordConfidence = chordConfidence;
+    slot.tempoBpm = tempoBpm;
+    slot.beatPhase = beatPhase;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        slot.levels[channel] = meters.getBlockPeak (channel);
+
+    if (activeChannelAudio != nullptr)
+        juce::FloatVectorOperations::copy (slot.audio, activeChannelAudio, slot.numSamples);
+    else
+        slot.numSamples = 0;
+
+    slot.sequence.store (nextSequence, std::memory_order_release);
+    header->sequence.store (nextSequence, std::memory_order_release);
+    ++nextSequence;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Metering.h"
+
+//==============================================================================
+/**
+    Shared-memory bus between the JUCE engine and the Python agent system.
+
+    The C++ counterpart of src/memory/shared_memory.py: a POSIX shm segment
+    holding a fixed header plus a ring of sequence-numbered slots. The audio
+    thread publishes one slot per block - active-channel audio, per-channel
+    peak levels, and the latest chord estimate - finishing each write with a
+    release store of the slot's sequence number. Python polls the header
+    sequence and reads the newest slot without copies or syscalls, so the
+    agents no longer need their own sounddevice capture stream.
+
+    Segment layout:
+        BusHeader | BusSlot[numSlots]
+*/
+class SharedMemoryBus
+{
+public:
+    static constexpr const char* segmentName = "/performia_bus";
+    static constexpr juce::uint32 busMagic = 0x4d485350;   // 'PSHM'
+    static constexpr juce::uint32 busVersion = 2;
+    static constexpr int numSlots = 8;
+    static constexpr int maxChannels = LevelMeterBank::maxChannels;
+    static constexpr int maxSlotSamples = 2048;
+
+    struct BusHeader
+    {
+        juce::uint32 magic;
+        juce::uint32 version;
+        juce::uint32 numChannels;
+        juce::uint32 slotCount;
+        juce::uint32 slotSamples;
+        juce::uint32 reserved;
+        double sampleRate;
+        std::atomic<juce::uint64> sequence;   // Last published slot sequence
+    };
+
+    struct BusSlot
+    {
+        std::atomic<juce::uint64> sequence;
+        juce::int64 samplePosition;
+        juce::int32 numSamples;
+        juce::int32 chord;
+        float chordConfidence;
+        float tempoBpm;
+        float beatPhase;
+        juce::int32 pad;   // Keeps the layout explicit for the Python reader
+        float levels[maxChannels];
+        float audio[maxSlotSamples];
+    };
+
+    SharedMemoryBus() = default;
+    ~SharedMemoryBus();
+
+    /** Creates (or re-creates) the segment. Called from prepare, not the callback. */
+    bool create (int numChannelsToPublish, double sampleRateToUse);
+    void close();
+
+    bool isOpen() const { return header != nullptr; }
+
+    /** Audio thread: copies one block into the next ring slot and publishes it. */
+    void publishBlock (const float* activeChannelAudio, int numSamples,
+                       juce::int64 samplePosition, const LevelMeterBank& meters,
+                       int chord, float chordConfidence,
+                       float tempoBpm, float beatPhase);
+
+private:
+    BusHeader* header = nullptr;
+    BusSlot* slots = nullptr;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    int shmFd = -1;
+    int numChannels = 0;
+    juce::uint64 nextSequence = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryBus)
+};
@@ -0,0 +1,169 @@
+#include "VoicePool.h"
+
+//==============================================================================
+VoicePool::VoicePool()
+{
+    // Stagger the noise seeds so simultaneous drum hits don't correlate
+    for (int i = 0; i < maxVoices; ++i)
+        voices[i].noiseState = 0x12345678u + (juce::uint32) (i * 0x9e3779b9u);
+}
+
+void VoicePool::prepare (double sampleRateToUse, int maxBlockSize)
+{
+    sampleRate = sampleRateToUse;
+    scratch.setSize (1, maxBlockSize);
+
+    for (auto& voice : voices)
+        voice.active = false;
+}
+
+int VoicePool::getNumActiveVoices() const
+{
+    int count = 0;
+    for (auto& voice : voices)
+        if (voice.active)
+            ++count;
+    return count;
+}
+
+//==============================================================================
+void VoicePool::noteOn (int voiceType, float midiNote, float velocity)
+{
+    const auto type = (VoiceType) juce::jlimit (0, 3, voiceType);
+
+    // Free slot first, quietest active voice as the steal target
+    Voice* target = nullptr;
+    for (auto& voice : voices)
+    {
+        if (! voice.active)
+        {
+            target = &voice;
+            break;
+        }
+
+        if (target == nullptr || voice.envelope < target->envelope)
+            target = &voice;
+    }
+
+    startVoice (*target, type, midiNote, velocity);
+}
+
+void VoicePool::startVoice (Voice& voice, VoiceType type, float midiNote, float velocity)
+{
+    const auto frequency = 440.0 * std::pow (2.0, (midiNote - 69.0) / 12.0);
+
+    voice.type = type;
+    voice.phase = 0.0f;
+    voice.phaseIncrement = (float) (frequency / sampleRate);
+    voice.envelope = 1.0f;
+    voice.filterState = 0.0f;
+    voice.amplitude = juce::jlimit (0.0f, 1.0f, velocity) * 0.25f;
+
+    // Per-role tunings: decay time and filter cutoff (as a one-pole
+    // coefficient) chosen to roughly match the SuperCollider patches
+    double decaySeconds;
+    float cutoff;
+
+    switch (type)
+    {
+        case VoiceType::drums:
+            decaySeconds = 0.12;
+            cutoff = juce::jlimit (0.05f, 0.9f, voice.phaseIncrement * 40.0f);
+            break;
+        case VoiceType::bass:
+            voice.phaseIncrement *= 0.5f;    // Down an octave
+            decaySeconds = 0.4;
+            cutoff = 0.08f;
+            break;
+        case VoiceType::melody:
+            decaySeconds = 0.5;
+            cutoff = 0.35f;
+            break;
+        case VoiceType::harmony:
+        default:
+            decaySeconds = 0.9;
+            cutoff = 0.15f;
+            break;
+    }
+
+    voice.decayMultiplier = (float) std::exp (-1.0 / (decaySeconds * sampleRate));
+    voice.filterCoefficient = cutoff;
+    voice.active = true;
+}
+
+//==============================================================================
+void VoicePool::renderVoice (Voice& voice, float* dest, int numSamples)
+{
+    float phase = voice.phase;
+    const float increment = voice.phaseIncrement;
+    float envelope = voice.envelope;
+    const float decay = voice.decayMultiplier;
+    float filter = voice.filterState;
+    const float coefficient = voice.filterCoefficient;
+    const float amplitude = voice.amplitude;
+
+    if (voice.type == VoiceType::drums)
+    {
+        auto state = voice.noiseState;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // xorshift noise -> one-pole low-pass -> decay envelope
+            state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+            const float sample = (float) (juce::int32) state * (1.0f / 2147483648.0f);
+
+            filter += coefficient * (sample - filter);
+            dest[i] += filter * envelope * amplitude;
+            envelope *= decay;
+        }
+
+        voice.noiseState = state;
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Saw -> one-pole low-pass -> decay envelope
+            const float sample = 2.0f * phase - 1.0f;
+            phase += increment;
+            if (phase >= 1.0f)
+                phase -= 1.0f;
+
+            filter += coefficient * (sample - filter);
+            dest[i] += filter * envelope * amplitude;
+            envelope *= decay;
+        }
+    }
+
+    voice.phase = phase;
+    voice.envelope = envelope;
+    voice.filterState = filter;
+
+    if (envelope < 1.0e-4f)
+        voice.active = false;
+}
+
+void VoicePool::renderBlock (juce::AudioBuffer<float>& buffer, int startSample,
+                             int numSamples, int numOutputChannels,
+                             float gainStart, float gainEnd)
+{
+    bool anyActive = false;
+    for (auto& voice : voices)
+        anyActive = anyActive || voice.active;
+
+    if (! anyActive)
+        return;
+
+    scratch.clear (0, 0, numSamples);
+    auto* mix = scratch.getWritePointer (0);
+
+    for (auto& voice : voices)
+        if (voice.active)
+            renderVoice (voice, mix, numSamples);
+
+    scratch.applyGainRamp (0, 0, numSamples, gainStart, gainEnd);
+
+    const int channelsInBuffer = buffer.getNumChannels();
+    for (int channel = 0; channel < numOutputChannels && channel < channelsInBuffer; ++channel)
+        buffer.addFrom (channel, startSample, scratch, 0, 0, numSamples);
+}
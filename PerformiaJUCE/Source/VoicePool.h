@@ -0,0 +1,63 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Fixed-size pool of native synthesis voices for the agents.
+
+    Small gigs shouldn't need the SuperCollider process hop: the OSC bridge's
+    note events trigger voices here and they render inside the engine graph.
+    Each voice is basic subtractive synthesis - saw or noise source, one-pole
+    low-pass, exponential decay envelope - with per-type tunings matching the
+    agent roles in src/agents/ (drums, bass, melody, harmony). Everything is
+    preallocated; note-on picks a free (or the quietest) slot, so there is no
+    allocation or locking anywhere on the audio thread.
+*/
+class VoicePool
+{
+public:
+    static constexpr int maxVoices = 32;
+
+    enum class VoiceType { drums = 0, bass, melody, harmony };
+
+    VoicePool();
+
+    void prepare (double sampleRateToUse, int maxBlockSize);
+
+    /** Audio thread: starts a voice. Steals the quietest slot when full. */
+    void noteOn (int voiceType, float midiNote, float velocity);
+
+    /** Audio thread: renders every active voice and adds the mix to all
+        output channels with the block's gain ramp.
+    */
+    void renderBlock (juce::AudioBuffer<float>& buffer, int startSample,
+                      int numSamples, int numOutputChannels,
+                      float gainStart, float gainEnd);
+
+    int getNumActiveVoices() const;
+
+private:
+    struct Voice
+    {
+        bool active = false;
+        VoiceType type = VoiceType::melody;
+        float phase = 0.0f;
+        float phaseIncrement = 0.0f;
+        float envelope = 0.0f;
+        float decayMultiplier = 0.0f;
+        float filterState = 0.0f;
+        float filterCoefficient = 0.2f;
+        float amplitude = 0.0f;
+        juce::uint32 noiseState = 0x12345678;
+    };
+
+    void startVoice (Voice& voice, VoiceType type, float midiNote, float velocity);
+    void renderVoice (Voice& voice, float* dest, int numSamples);
+
+    Voice voices[maxVoices];
+    juce::AudioBuffer<float> scratch;
+    double sampleRate = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoicePool)
+};
@@ -0,0 +1,86 @@
+#include "WaveformComponent.h"
+
+//==============================================================================
+WaveformComponent::WaveformComponent (WaveformHistory& historyToDraw)
+    : history (historyToDraw)
+{
+    setOpaque (false);
+    setInterceptsMouseClicks (false, false);
+    startTimerHz (30);
+}
+
+void WaveformComponent::setVisibleDuration (double seconds)
+{
+    visibleSeconds = juce::jmax (0.1, seconds);
+    resized();
+}
+
+void WaveformComponent::resized()
+{
+    // Worst case is the base level with several entries per pixel; sized
+    // here so paint() never allocates
+    const double samplesPerPixel = visibleSeconds * history.getSampleRate()
+                                     / juce::jmax (1, getWidth());
+    const int entriesNeeded = (int) (samplesPerPixel * getWidth()
+                                       / WaveformHistory::getLevelFactor (0)) + 2;
+    readBuffer.resize ((size_t) juce::jmax (entriesNeeded, getWidth()));
+}
+
+void WaveformComponent::paint (juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour (juce::Colour (0xff1a1a1a));
+    g.fillRoundedRectangle (bounds, 5.0f);
+
+    const int width = getWidth();
+    if (width <= 0 || readBuffer.empty())
+        return;
+
+    const double samplesPerPixel = visibleSeconds * history.getSampleRate() / width;
+
+    // Coarsest level that still gives at least one entry per pixel
+    int level = 0;
+    for (int i = WaveformHistory::numLevels; --i >= 0;)
+    {
+        if (WaveformHistory::getLevelFactor (i) <= samplesPerPixel)
+        {
+            level = i;
+            break;
+        }
+    }
+
+    const double entriesPerPixel = samplesPerPixel / WaveformHistory::getLevelFactor (level);
+    const int entriesWanted = juce::jmin ((int) readBuffer.size(),
+                                          (int) (entriesPerPixel * width) + 1);
+
+    const int entriesRead = history.readLevel (level, readBuffer.data(), entriesWanted);
+    if (entriesRead <= 0)
+        return;
+
+    const float midY = bounds.getCentreY();
+    const float halfHeight = bounds.getHeight() * 0.48f;
+
+    g.setColour (juce::Colour (0xff00d9ff));
+
+    // Right-aligned: the newest entry lands on the right edge
+    for (int x = width - 1; x >= 0; --x)
+    {
+        const int bucketEnd = entriesRead - (int) ((width - 1 - x) * entriesPerPixel);
+        const int bucketStart = juce::jmax (0, bucketEnd - juce::jmax (1, (int) entriesPerPixel));
+
+        if (bucketEnd <= 0)
+            break;
+
+        float low = readBuffer[(size_t) bucketStart].minValue;
+        float high = readBuffer[(size_t) bucketStart].maxValue;
+
+        for (int i = bucketStart + 1; i < bucketEnd; ++i)
+        {
+            low = juce::jmin (low, readBuffer[(size_t) i].minValue);
+            high = juce::jmax (high, readBuffer[(size_t) i].maxValue);
+        }
+
+        g.drawVerticalLine (x, midY - high * halfHeight, midY - low * halfHeight);
+    }
+}
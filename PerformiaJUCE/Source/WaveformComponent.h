@@ -0,0 +1,35 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "WaveformHistory.h"
+
+//==============================================================================
+/**
+    Scrolling view of the recent input waveform.
+
+    Each repaint picks the pyramid level whose decimation factor fits the
+    current samples-per-pixel ratio, reads just enough entries to cover the
+    window, and draws one min/max line per pixel column - O(pixels) whatever
+    the zoom or history length.
+*/
+class WaveformComponent : public juce::Component,
+                          private juce::Timer
+{
+public:
+    explicit WaveformComponent (WaveformHistory& historyToDraw);
+
+    /** Sets how many seconds of history the view spans. */
+    void setVisibleDuration (double seconds);
+
+    void paint (juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void timerCallback() override { repaint(); }
+
+    WaveformHistory& history;
+    double visibleSeconds = 10.0;
+    std::vector<WaveformHistory::MinMax> readBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformComponent)
+};
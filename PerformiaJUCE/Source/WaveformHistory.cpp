@@ -0,0 +1,133 @@
+#include "WaveformHistory.h"
+
+//==============================================================================
+WaveformHistory::WaveformHistory() = default;
+
+void WaveformHistory::prepare (double sampleRateToUse)
+{
+    sampleRate = sampleRateToUse;
+    sampleFifo.reset();
+
+    for (auto& level : levels)
+    {
+        level.written.store (0, std::memory_order_relaxed);
+        level.accumulator = {};
+        level.countInAccumulator = 0;
+    }
+}
+
+void WaveformHistory::pushSamples (const float* samples, int numSamples)
+{
+    int start1, size1, start2, size2;
+    sampleFifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        juce::FloatVectorOperations::copy (sampleRing + start1, samples, size1);
+    if (size2 > 0)
+        juce::FloatVectorOperations::copy (sampleRing + start2, samples + size1, size2);
+
+    sampleFifo.finishedWrite (size1 + size2);
+}
+
+int WaveformHistory::readLevel (int level, MinMax* dest, int numEntries) const
+{
+    const auto& source = levels[level];
+    const auto written = source.written.load (std::memory_order_acquire);
+
+    const int available = (int) juce::jmin ((juce::int64) numEntries,
+                                            written,
+                                            (juce::int64) levelSize);
+
+    for (int i = 0; i < available; ++i)
+        dest[i] = source.entries[(written - available + i) & (levelSize - 1)];
+
+    return available;
+}
+
+//==============================================================================
+void WaveformHistory::processPending()
+{
+    float scratch[4096];
+
+    for (;;)
+    {
+        const int ready = sampleFifo.getNumReady();
+        if (ready <= 0)
+            return;
+
+        const int toRead = juce::jmin (ready, (int) sizeof (scratch) / (int) sizeof (float));
+
+        int start1, size1, start2, size2;
+        sampleFifo.prepareToRead (toRead, start1, size1, start2, size2);
+
+        if (size1 > 0)
+            juce::FloatVectorOperations::copy (scratch, sampleRing + start1, size1);
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy (scratch + size1, sampleRing + start2, size2);
+
+        sampleFifo.finishedRead (size1 + size2);
+
+        consume (scratch, size1 + size2);
+    }
+}
+
+void WaveformHistory::consume (const float* samples, int numSamples)
+{
+    // Base level: fold raw samples into 1/64 min/max buckets. Higher levels
+    // are cascaded from completed entries in appendToLevel, so each sample
+    // is visited exactly once regardless of how many levels exist.
+    auto& base = levels[0];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float sample = samples[i];
+
+        if (base.countInAccumulator == 0)
+        {
+            base.accumulator.minValue = sample;
+            base.accumulator.maxValue = sample;
+        }
+        else
+        {
+            base.accumulator.minValue = juce::jmin (base.accumulator.minValue, sample);
+            base.accumulator.maxValue = juce::jmax (base.accumulator.maxValue, sample);
+        }
+
+        if (++base.countInAccumulator >= getLevelFactor (0))
+        {
+            appendToLevel (0, base.accumulator);
+            base.countInAccumulator = 0;
+        }
+    }
+}
+
+void WaveformHistory::appendToLevel (int level, const MinMax& entry)
+{
+    auto& target = levels[level];
+    const auto written = target.written.load (std::memory_order_relaxed);
+
+    target.entries[written & (levelSize - 1)] = entry;
+    target.written.store (written + 1, std::memory_order_release);
+
+    // Cascade: eight completed entries here make one entry a level up
+    if (level + 1 < numLevels)
+    {
+        auto& next = levels[level + 1];
+
+        if (next.countInAccumulator == 0)
+        {
+            next.accumulator = entry;
+        }
+        else
+        {
+            next.accumulator.minValue = juce::jmin (next.accumulator.minValue, entry.minValue);
+            next.accumulator.maxValue = juce::jmax (next.accumulator.maxValue, entry.maxValue);
+        }
+
+        if (++next.countInAccumulator >= 8)
+        {
+            appendToLevel (level + 1, next.accumulator);
+            next.countInAccumulator = 0;
+        }
+    }
+}
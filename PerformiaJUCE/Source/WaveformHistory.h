@@ -0,0 +1,75 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Scrolling waveform history with a min/max decimation pyramid.
+
+    The audio callback's only cost is one ring write per block. A low-tier
+    job on the shared worker pool drains the ring and maintains three mip
+    levels of min/max pairs at 1/64, 1/512 and 1/4096 decimation, each level
+    cascaded from the one below so a sample is touched exactly once. The GUI
+    picks whichever level is at or below its samples-per-pixel ratio and
+    aggregates from there, making a repaint O(pixels) no matter how much
+    history is buffered.
+*/
+class WaveformHistory
+{
+public:
+    struct MinMax
+    {
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+    };
+
+    static constexpr int numLevels = 3;
+    static constexpr int levelSize = 1 << 15;      // Entries per level ring
+
+    WaveformHistory();
+
+    void prepare (double sampleRateToUse);
+
+    /** Audio thread: feeds one block of the active input channel. Never blocks. */
+    void pushSamples (const float* samples, int numSamples);
+
+    /** Worker-pool job body: drains the ring into the pyramid. The engine
+        keeps at most one job in flight, so the builder state is single-writer.
+    */
+    void processPending();
+
+    //==============================================================================
+    // Message-thread readers
+    static int getLevelFactor (int level) { return 64 << (3 * level); }
+    double getSampleRate() const          { return sampleRate; }
+
+    /** Copies the newest numEntries of a level into dest, oldest first.
+        Returns how many were actually available.
+    */
+    int readLevel (int level, MinMax* dest, int numEntries) const;
+
+private:
+    void consume (const float* samples, int numSamples);
+
+    struct Level
+    {
+        MinMax entries[levelSize];
+        std::atomic<juce::int64> written { 0 };
+
+        // Builder state, one worker-pool job at a time
+        MinMax accumulator;
+        int countInAccumulator = 0;
+    };
+
+    void appendToLevel (int level, const MinMax& entry);
+
+    // Callback -> builder job sample ring
+    static constexpr int ringSize = 1 << 15;
+    juce::AbstractFifo sampleFifo { ringSize };
+    float sampleRing[ringSize];
+
+    Level levels[numLevels];
+    double sampleRate = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformHistory)
+};
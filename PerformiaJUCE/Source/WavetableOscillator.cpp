@@ -0,0 +1,50 @@
+#include "WavetableOscillator.h"
+
+WavetableOscillator::WavetableOscillator()
+{
+    for (int i = 0; i <= tableSize; ++i)
+    {
+        const double normalised = (double) i / (double) tableSize;
+        sineTable[i] = (float) std::sin (2.0 * juce::MathConstants<double>::pi * normalised);
+        sawTable[i] = (float) (2.0 * normalised - 1.0);
+    }
+}
+
+void WavetableOscillator::prepare (double sampleRateToUse)
+{
+    sampleRate = sampleRateToUse;
+    phase = 0.0f;
+}
+
+void WavetableOscillator::setFrequency (double frequencyHz)
+{
+    phaseIncrement = (float) (frequencyHz * (double) tableSize / sampleRate);
+}
+
+void WavetableOscillator::renderBlock (float* dest, int numSamples, float gain)
+{
+    if (waveform == Waveform::noise)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = (noise.nextFloat() * 2.0f - 1.0f) * gain;
+        return;
+    }
+
+    const float* table = waveform == Waveform::sine ? sineTable : sawTable;
+    float currentPhase = phase;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int index = (int) currentPhase;
+        const float frac = currentPhase - (float) index;
+
+        // Guard point at tableSize makes the wrap-around interpolation safe
+        dest[i] = (table[index] + frac * (table[index + 1] - table[index])) * gain;
+
+        currentPhase += phaseIncrement;
+        if (currentPhase >= (float) tableSize)
+            currentPhase -= (float) tableSize;
+    }
+
+    phase = currentPhase;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+    Block-based wavetable oscillator for test and line-check signals.
+
+    Replaces per-sample double-precision std::sin calls with a precomputed
+    table walked by a phase accumulator with linear interpolation. One
+    renderBlock() fills a single channel; a multi-channel line check is then
+    just FloatVectorOperations::copy to the remaining outputs, so an N-channel
+    tone costs one table walk plus memcpys instead of N transcendental loops.
+*/
+class WavetableOscillator
+{
+public:
+    enum class Waveform { sine, saw, noise };
+
+    WavetableOscillator();
+
+    void prepare (double sampleRateToUse);
+    void reset() { phase = 0.0f; }
+
+    void setFrequency (double frequencyHz);
+    void setWaveform (Waveform newWaveform) { waveform = newWaveform; }
+
+    /** Renders one block into dest (replacing its contents), scaled by gain. */
+    void renderBlock (float* dest, int numSamples, float gain);
+
+private:
+    static constexpr int tableSize = 2048;  // Power of two; +1 guard point for interpolation
+
+    float sineTable[tableSize + 1];
+    float sawTable[tableSize + 1];
+
+    float phase = 0.0f;           // In table units [0, tableSize)
+    float phaseIncrement = 0.0f;  // Table units per sample
+    double sampleRate = 48000.0;
+    Waveform waveform = Waveform::sine;
+    juce::Random noise;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableOscillator)
+};
@@ -0,0 +1,155 @@
+#include "WorkerPool.h"
+
+//==============================================================================
+bool WorkerPool::JobRing::push (const Job& job)
+{
+    const auto currentTail = tail.load (std::memory_order_relaxed);
+    const auto currentHead = head.load (std::memory_order_acquire);
+
+    if (currentTail - currentHead >= (juce::uint32) capacity)
+        return false;
+
+    jobs[currentTail % (juce::uint32) capacity] = job;
+    tail.store (currentTail + 1, std::memory_order_release);
+    return true;
+}
+
+bool WorkerPool::JobRing::steal (Job& job)
+{
+    auto currentHead = head.load (std::memory_order_acquire);
+
+    for (;;)
+    {
+        if (currentHead == tail.load (std::memory_order_acquire))
+            return false;
+
+        job = jobs[currentHead % (juce::uint32) capacity];
+
+        // Winning the CAS claims the slot; losing means another worker (or
+        // the owner) took it first, so re-read and try the next one
+        if (head.compare_exchange_weak (currentHead, currentHead + 1,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire))
+            return true;
+    }
+}
+
+//==============================================================================
+class WorkerPool::Worker : public juce::Thread
+{
+public:
+    Worker (WorkerPool& poolToUse, int workerIndex)
+        : juce::Thread ("Analysis Worker " + juce::String (workerIndex + 1)),
+          pool (poolToUse), index (workerIndex)
+    {
+    }
+
+    void run() override
+    {
+        // Pin onto the cores after 0/1, wrapping when there are more workers
+        // than spare cores. On a 2-core machine there is nowhere to hide, so
+        // leave the scheduler alone.
+        const int numCores = juce::SystemStats::getNumCpus();
+        if (numCores > 2)
+            setCurrentThreadAffinityMask (1u << (2 + (index % (numCores - 2))));
+
+        while (! threadShouldExit())
+        {
+            if (! pool.runOneJob (index))
+                wait (2);
+        }
+    }
+
+    JobRing rings[numPriorities];
+
+private:
+    WorkerPool& pool;
+    const int index;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+WorkerPool::WorkerPool() = default;
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+void WorkerPool::start (int numThreads)
+{
+    if (! workers.isEmpty())
+        return;
+
+    if (numThreads <= 0)
+        numThreads = juce::jmax (1, juce::SystemStats::getNumCpus() - 2);
+
+    for (int i = 0; i < numThreads; ++i)
+        workers.add (new Worker (*this, i));
+
+    // High OS priority like the old dedicated chord thread had; the tier
+    // ordering inside runOneJob keeps decimation from starving detection
+    for (auto* worker : workers)
+        worker->startThread (juce::Thread::Priority::high);
+}
+
+void WorkerPool::stop()
+{
+    for (auto* worker : workers)
+        worker->signalThreadShouldExit();
+    for (auto* worker : workers)
+        worker->notify();
+    for (auto* worker : workers)
+        worker->stopThread (2000);
+
+    workers.clear();
+}
+
+bool WorkerPool::submit (Priority priority, JobFunction function, void* context)
+{
+    const int numWorkers = workers.size();
+    if (numWorkers == 0)
+        return false;
+
+    const Job job { function, context };
+    const auto first = nextWorker.fetch_add (1, std::memory_order_relaxed);
+
+    // Round-robin for balance, falling through to the next worker's ring
+    // when one is full
+    for (int attempt = 0; attempt < numWorkers; ++attempt)
+    {
+        auto* worker = workers.getUnchecked ((int) ((first + (juce::uint32) attempt)
+                                                     % (juce::uint32) numWorkers));
+        if (worker->rings[(int) priority].push (job))
+        {
+            worker->notify();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool WorkerPool::runOneJob (int workerIndex)
+{
+    const int numWorkers = workers.size();
+    Job job;
+
+    for (int tier = 0; tier < numPriorities; ++tier)
+    {
+        // Own ring first, then steal from the neighbours in order
+        for (int offset = 0; offset < numWorkers; ++offset)
+        {
+            auto* worker = workers.getUnchecked ((workerIndex + offset) % numWorkers);
+
+            if (worker->rings[tier].steal (job))
+            {
+                job.function (job.context);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+//==============================================================================
+/**
+    Shared worker pool for per-block analysis jobs.
+
+    Chord detection, onset tracking and waveform decimation each used to own
+    a thread; every new analysis stage meant another one fighting the audio
+    callback and the UI for cores. The pool runs a fixed set of workers
+    (default cores minus two, so cores 0/1 stay free for the callback and
+    message threads, each worker pinned to one of the remaining cores) and
+    the engine enqueues one job per stage per block instead.
+
+    Jobs are plain function-pointer + context pairs in fixed-capacity rings -
+    submission from the audio thread is one slot write, no allocation, no
+    locks. Each worker owns one ring per priority tier and steals from its
+    neighbours when its own are empty; every high-tier job anywhere in the
+    pool runs before any low-tier job, so chord detection preempts waveform
+    decimation when cores are scarce.
+*/
+class WorkerPool
+{
+public:
+    enum class Priority { high = 0, low = 1 };
+    static constexpr int numPriorities = 2;
+
+    using JobFunction = void (*) (void* context);
+
+    WorkerPool();
+    ~WorkerPool();
+
+    /** Spins up the workers. numThreads <= 0 picks cores-2 (minimum one).
+        Calling again while running is a no-op, so prepare() can call this
+        freely across device restarts.
+    */
+    void start (int numThreads = 0);
+    void stop();
+
+    /** Audio thread: enqueues one job. Lock-free; returns false when every
+        ring is full, in which case the caller just resubmits next block -
+        the stages' sample FIFOs hold the data either way.
+
+        Only one thread may submit (the rings are single-producer).
+    */
+    bool submit (Priority priority, JobFunction function, void* context);
+
+    int getNumWorkers() const { return workers.size(); }
+
+private:
+    struct Job
+    {
+        JobFunction function = nullptr;
+        void* context = nullptr;
+    };
+
+    /** Fixed-capacity single-producer / multi-consumer ring. The audio
+        thread pushes at the tail; the owning worker and any thieves race on
+        the head with compare-exchange, so a steal is one CAS.
+    */
+    struct JobRing
+    {
+        static constexpr int capacity = 256;
+
+        Job jobs[capacity];
+        std::atomic<juce::uint32> head { 0 };
+        std::atomic<juce::uint32> tail { 0 };
+
+        bool push (const Job& job);
+        bool steal (Job& job);
+    };
+
+    class Worker;
+
+    /** Runs the next due job as seen from one worker: own high ring, stolen
+        high rings, own low ring, stolen low rings. Returns false when the
+        whole pool is drained.
+    */
+    bool runOneJob (int workerIndex);
+
+    juce::OwnedArray<Worker> workers;
+    std::atomic<juce::uint32> nextWorker { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerPool)
+};
@@ -0,0 +1,113 @@
+"""
+Reader for the shared-memory audio bus published by the JUCE engine
+
+The native engine (PerformiaJUCE) maps a POSIX shm segment named
+"performia_bus" and writes one sequence-numbered slot per audio block:
+the active input channel's raw samples, per-channel peak levels, and the
+latest chord estimate. Polling the header sequence number is a single
+memory read, so agents can consume live audio and analysis without their
+own capture stream or any syscalls on the hot path.
+"""
+
+import struct
+import numpy as np
+from multiprocessing import shared_memory
+from typing import Optional, Dict
+import logging
+
+logger = logging.getLogger(__name__)
+
+SEGMENT_NAME = "performia_bus"
+BUS_MAGIC = 0x4D485350  # 'PSHM'
+BUS_VERSION = 2
+MAX_CHANNELS = 64
+MAX_SLOT_SAMPLES = 2048
+
+# Matches SharedMemoryBus::BusHeader / BusSlot in the JUCE engine
+# (natural alignment: uint64 sequence fields are 8-byte aligned)
+HEADER_FORMAT = "<IIIIII d Q"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+SLOT_HEADER_FORMAT = "<Q q i i f f f i"
+SLOT_HEADER_SIZE = struct.calcsize(SLOT_HEADER_FORMAT)
+SLOT_SIZE = SLOT_HEADER_SIZE + 4 * MAX_CHANNELS + 4 * MAX_SLOT_SAMPLES
+
+
+class ShmAudioBus:
+    """Polls the engine's shared-memory segment for audio blocks"""
+
+    def __init__(self, name: str = SEGMENT_NAME):
+        try:
+            self.shm = shared_memory.SharedMemory(name=name, create=False)
+        except FileNotFoundError:
+            raise RuntimeError(
+                "Shared-memory bus not found - is the Performia engine running?"
+            )
+
+        magic, version, num_channels, slot_count, slot_samples, _, sample_rate, _ = \
+            struct.unpack_from(HEADER_FORMAT, self.shm.buf, 0)
+
+        if magic != BUS_MAGIC:
+            raise RuntimeError(f"Bad shm magic 0x{magic:08x} - segment not ready")
+        if version != BUS_VERSION:
+            raise RuntimeError(f"Unsupported bus version {version}")
+
+        self.num_channels = num_channels
+        self.slot_count = slot_count
+        self.slot_samples = slot_samples
+        self.sample_rate = sample_rate
+        self.last_sequence = 0
+
+        logger.info(
+            f"✓ Attached to shm audio bus ({num_channels} channels @ {sample_rate:.0f} Hz)"
+        )
+
+    def poll(self) -> Optional[Dict]:
+        """Return the newest unseen block, or None if nothing new
+
+        Zero-copy on the fast path: the sequence check is one memory read.
+        A slot being overwritten mid-read is detected by re-checking its
+        sequence number after the copy and skipped.
+        """
+        (sequence,) = struct.unpack_from("<Q", self.shm.buf, HEADER_SIZE - 8)
+        if sequence == 0 or sequence == self.last_sequence:
+            return None
+
+        slot_offset = HEADER_SIZE + (sequence % self.slot_count) * SLOT_SIZE
+        slot_seq, sample_position, num_samples, chord, confidence, tempo_bpm, beat_phase, _ = \
+            struct.unpack_from(SLOT_HEADER_FORMAT, self.shm.buf, slot_offset)
+
+        levels_offset = slot_offset + SLOT_HEADER_SIZE
+        audio_offset = levels_offset + 4 * MAX_CHANNELS
+
+        levels = np.frombuffer(
+            self.shm.buf, dtype=np.float32,
+            count=self.num_channels, offset=levels_offset
+        ).copy()
+        audio = np.frombuffer(
+            self.shm.buf, dtype=np.float32,
+            count=max(num_samples, 0), offset=audio_offset
+        ).copy()
+
+        # Torn read: the writer lapped us while copying
+        (slot_seq_after,) = struct.unpack_from("<Q", self.shm.buf, slot_offset)
+        if slot_seq_after != slot_seq or slot_seq != sequence:
+            return None
+
+        self.last_sequence = sequence
+        return {
+            "sequence": sequence,
+            "sample_position": sample_position,
+            "audio": audio,
+            "levels": levels,
+            "chord": chord,
+            "confidence": confidence,
+            "tempo_bpm": tempo_bpm,
+            "beat_phase": beat_phase,
+        }
+
+    def cleanup(self):
+        """Detach from the segment (the engine owns its lifetime)"""
+        try:
+            self.shm.close()
+        except:
+            pass